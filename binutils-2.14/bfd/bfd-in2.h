@@ -839,6 +839,9 @@ extern bfd_boolean bfd_elf32_arm_process_before_allocation
 extern bfd_boolean bfd_elf32_arm_get_bfd_for_interworking
   PARAMS ((bfd *, struct bfd_link_info *));
 
+extern bfd_boolean bfd_elf32_arm_set_pic_veneer
+  PARAMS ((struct bfd_link_info *, int));
+
 extern bfd_boolean bfd_elf32_arm_add_glue_sections_to_bfd
   PARAMS ((bfd *, struct bfd_link_info *));
 
@@ -204,6 +204,10 @@ struct elf32_arm_link_hash_table
     /* A boolean indicating whether knowledge of the ARM's pipeline
        length should be applied by the linker.  */
     int no_pipeline_knowledge;
+
+    /* A boolean indicating whether the ARM-to-Thumb glue should be
+       position independent.  */
+    int pic_veneer;
   };
 
 /* Create an entry in an ARM ELF linker hash table.  */
@@ -260,6 +264,7 @@ elf32_arm_link_hash_table_create (abfd)
   ret->arm_glue_size = 0;
   ret->bfd_of_glue_owner = NULL;
   ret->no_pipeline_knowledge = 0;
+  ret->pic_veneer = 0;
 
   return &ret->root.root;
 }
@@ -343,11 +348,30 @@ find_arm_glue (link_info, name, input_bfd)
    __func_addr:
    .word func    @ behave as if you saw a ARM_32 reloc.  */
 
-#define ARM2THUMB_GLUE_SIZE 12
+#define ARM2THUMB_STATIC_GLUE_SIZE 12
 static const insn32 a2t1_ldr_insn = 0xe59fc000;
 static const insn32 a2t2_bx_r12_insn = 0xe12fff1c;
 static const insn32 a2t3_func_addr_insn = 0x00000001;
 
+/* ARM->Thumb glue for code that may be loaded at any address, such as
+   a Palm OS armlet:
+
+   .arm
+   __func_from_arm:
+   ldr r12, __func_offset
+   add r12, r12, pc
+   bx  r12
+   __func_offset:
+   .word func + 1 - .  */
+
+#define ARM2THUMB_PIC_GLUE_SIZE 16
+static const insn32 a2t1p_ldr_insn = 0xe59fc004;
+static const insn32 a2t2p_add_pc_insn = 0xe08cc00f;
+static const insn32 a2t3p_bx_r12_insn = 0xe12fff1c;
+
+#define ARM2THUMB_GLUE_SIZE(globals) \
+  ((globals)->pic_veneer ? ARM2THUMB_PIC_GLUE_SIZE : ARM2THUMB_STATIC_GLUE_SIZE)
+
 /* Thumb->ARM:                          Thumb->(non-interworking aware) ARM
 
    .thumb                               .thumb
@@ -468,7 +492,7 @@ record_arm_to_thumb_glue (link_info, h)
 
   free (tmp_name);
 
-  globals->arm_glue_size += ARM2THUMB_GLUE_SIZE;
+  globals->arm_glue_size += ARM2THUMB_GLUE_SIZE (globals);
 
   return;
 }
@@ -636,6 +660,27 @@ bfd_elf32_arm_get_bfd_for_interworking (abfd, info)
   return TRUE;
 }
 
+/* Select position independent ARM-to-Thumb glue, for targets whose code
+   may be loaded anywhere.  This must be called before any glue is
+   recorded by bfd_elf32_arm_process_before_allocation.  */
+
+bfd_boolean
+bfd_elf32_arm_set_pic_veneer (info, pic_veneer)
+     struct bfd_link_info *info;
+     int pic_veneer;
+{
+  struct elf32_arm_link_hash_table *globals;
+
+  globals = elf32_arm_hash_table (info);
+
+  BFD_ASSERT (globals != NULL);
+  BFD_ASSERT (globals->arm_glue_size == 0);
+
+  globals->pic_veneer = pic_veneer;
+
+  return TRUE;
+}
+
 bfd_boolean
 bfd_elf32_arm_process_before_allocation (abfd, link_info, no_pipeline_knowledge)
      bfd *abfd;
@@ -1006,15 +1051,37 @@ elf32_arm_to_thumb_stub (info, name, input_bfd, output_bfd, input_section,
       --my_offset;
       myh->root.u.def.value = my_offset;
 
-      bfd_put_32 (output_bfd, (bfd_vma) a2t1_ldr_insn,
-		  s->contents + my_offset);
+      if (globals->pic_veneer)
+	{
+	  bfd_put_32 (output_bfd, (bfd_vma) a2t1p_ldr_insn,
+		      s->contents + my_offset);
+
+	  bfd_put_32 (output_bfd, (bfd_vma) a2t2p_add_pc_insn,
+		      s->contents + my_offset + 4);
+
+	  bfd_put_32 (output_bfd, (bfd_vma) a2t3p_bx_r12_insn,
+		      s->contents + my_offset + 8);
+
+	  /* The offset from where the add reads the pc, 12 bytes into the
+	     glue, to the thumb address, including its low order bit.  */
+	  bfd_put_32 (output_bfd,
+		      (val | a2t3_func_addr_insn)
+		      - (s->output_section->vma + s->output_offset
+			 + my_offset + 12),
+		      s->contents + my_offset + 12);
+	}
+      else
+	{
+	  bfd_put_32 (output_bfd, (bfd_vma) a2t1_ldr_insn,
+		      s->contents + my_offset);
 
-      bfd_put_32 (output_bfd, (bfd_vma) a2t2_bx_r12_insn,
-		  s->contents + my_offset + 4);
+	  bfd_put_32 (output_bfd, (bfd_vma) a2t2_bx_r12_insn,
+		      s->contents + my_offset + 4);
 
-      /* It's a thumb address.  Add the low order bit.  */
-      bfd_put_32 (output_bfd, val | a2t3_func_addr_insn,
-		  s->contents + my_offset + 8);
+	  /* It's a thumb address.  Add the low order bit.  */
+	  bfd_put_32 (output_bfd, val | a2t3_func_addr_insn,
+		      s->contents + my_offset + 8);
+	}
     }
 
   BFD_ASSERT (my_offset <= globals->arm_glue_size);
@@ -26,6 +26,8 @@
 	bfd_elf32_arm_oabi_process_before_allocation
 #define bfd_elf32_arm_add_glue_sections_to_bfd \
 	bfd_elf32_arm_oabi_add_glue_sections_to_bfd
+#define bfd_elf32_arm_set_pic_veneer \
+	bfd_elf32_arm_oabi_set_pic_veneer
 
 #include "elf/arm.h"
 #include "bfd.h"
@@ -1,5 +1,6 @@
 . ${srcdir}/emulparams/armelf.sh
 SCRIPT_NAME=armpalmos
+EXTRA_EM_FILE=armpalmos
 
 GENERATE_COMBRELOC_SCRIPT=yes
 unset GENERATE_SHLIB_SCRIPT
@@ -2,3 +2,4 @@ SCRIPT_NAME=m68kpalmos
 OUTPUT_FORMAT="coff-m68k"
 ARCH=m68k
 TEMPLATE_NAME=m68kcoff
+DATA_LIMIT=32767
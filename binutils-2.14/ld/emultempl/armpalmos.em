@@ -0,0 +1,60 @@
+# This shell script emits a C file. -*- C -*-
+#
+# This file is sourced from elf32.em, and adds to the arm-elf routines
+# what is particular to Palm OS armlets, which are loaded at arbitrary
+# addresses and are always entered in ARM state.
+
+. ${srcdir}/emultempl/armelf.em
+
+cat >>e${EMULATION_NAME}.c <<EOF
+
+#include "elf-bfd.h"
+#include "elf/arm.h"
+
+static void armpalmos_before_allocation PARAMS ((void));
+
+static void
+armpalmos_before_allocation ()
+{
+  /* Any ARM-to-Thumb glue must work wherever the armlet is loaded.  */
+  bfd_elf32_arm_set_pic_veneer (&link_info, TRUE);
+
+  arm_elf_before_allocation ();
+}
+
+static void armpalmos_finish PARAMS ((void));
+
+static void
+armpalmos_finish ()
+{
+  /* If the entry point is a Thumb function, treat it as if it had been
+     given with --thumb-entry.  The low bit of the start address is then
+     set, which tells build-prc to begin the code resource by switching
+     to Thumb state.  */
+  if (thumb_entry_symbol == NULL && ! link_info.relocateable)
+    {
+      const char *name = (entry_symbol.name != NULL)? entry_symbol.name
+						     : "start";
+      struct elf_link_hash_entry *h;
+
+      h = elf_link_hash_lookup (elf_hash_table (&link_info), name,
+				FALSE, FALSE, TRUE);
+
+      if (h != NULL
+	  && (h->root.type == bfd_link_hash_defined
+	      || h->root.type == bfd_link_hash_defweak)
+	  && ELF_ST_TYPE (h->type) == STT_ARM_TFUNC)
+	{
+	  thumb_entry_symbol = (char *) name;
+	  /* Not an override of -e, so don't let arm_elf_finish warn.  */
+	  entry_from_cmdline = FALSE;
+	}
+    }
+
+  arm_elf_finish ();
+}
+
+EOF
+
+LDEMUL_BEFORE_ALLOCATION=armpalmos_before_allocation
+LDEMUL_FINISH=armpalmos_finish
@@ -41,6 +41,7 @@ static void gld${EMULATION_NAME}_before_parse PARAMS ((void));
 static void gld${EMULATION_NAME}_after_open PARAMS ((void));
 static void check_sections PARAMS ((bfd *, asection *, PTR));
 static void gld${EMULATION_NAME}_after_allocation PARAMS ((void));
+static void gld${EMULATION_NAME}_finish PARAMS ((void));
 static char *gld${EMULATION_NAME}_get_script PARAMS ((int *isfile));
 
 static void
@@ -166,6 +167,46 @@ gld${EMULATION_NAME}_after_allocation ()
     }
 }
 
+/* If the emulation sets DATA_LIMIT, global data are accessed via 16 bit
+   offsets from a base register, so .data and .bss together can't exceed
+   DATA_LIMIT bytes.  The linker script's memory regions catch overflows;
+   here we warn when the data come within DATA_WARN_MARGIN bytes of the
+   limit, so that there's some notice before the link fails outright.  With
+   --verbose, the data size is always reported.  */
+
+#define DATA_LIMIT ${DATA_LIMIT-0}
+#define DATA_WARN_MARGIN 2048
+
+static void
+gld${EMULATION_NAME}_finish ()
+{
+  asection *datasec, *bsssec;
+  bfd_vma start, end;
+  unsigned size;
+
+  if (DATA_LIMIT == 0 || link_info.relocateable)
+    return;
+
+  datasec = bfd_get_section_by_name (output_bfd, ".data");
+  bsssec = bfd_get_section_by_name (output_bfd, ".bss");
+  if (datasec == NULL || bsssec == NULL)
+    return;
+
+  start = bfd_get_section_vma (output_bfd, datasec);
+  end = bfd_get_section_vma (output_bfd, bsssec)
+	+ bfd_section_size (output_bfd, bsssec);
+  size = end - start;
+
+  if (trace_file_tries)
+    info_msg (_("Global data: %u bytes (.data %u, .bss %u) of %u\n"),
+	      size, (unsigned) bfd_section_size (output_bfd, datasec),
+	      (unsigned) bfd_section_size (output_bfd, bsssec), DATA_LIMIT);
+
+  if (size <= DATA_LIMIT && size > DATA_LIMIT - DATA_WARN_MARGIN)
+    einfo (_("%P: warning: global data (%u bytes) within %u bytes of the %u byte limit\n"),
+	   size, DATA_LIMIT - size, DATA_LIMIT);
+}
+
 static char *
 gld${EMULATION_NAME}_get_script(isfile)
      int *isfile;
@@ -234,7 +275,7 @@ struct ld_emulation_xfer_struct ld_${EMULATION_NAME}_emulation =
   gld${EMULATION_NAME}_get_script,
   "${EMULATION_NAME}",
   "${OUTPUT_FORMAT}",
-  NULL,	/* finish */
+  gld${EMULATION_NAME}_finish,
   NULL,	/* create output section statements */
   NULL,	/* open dynamic archive */
   NULL,	/* place orphan */
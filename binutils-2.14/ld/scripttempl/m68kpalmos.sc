@@ -22,7 +22,7 @@ ${LIB_SEARCH_DIRS}
 MEMORY
 {
     coderes : ORIGIN = 0x0, LENGTH = 32770
-    datares : ORIGIN = 0x0, LENGTH = 32767
+    datares : ORIGIN = 0x0, LENGTH = ${DATA_LIMIT}
 	
     trap_region :	 ORIGIN = 0x1000000, LENGTH = 2
     disposition_region : ORIGIN = 0x1000010, LENGTH = 6
@@ -36,9 +36,13 @@ SECTIONS
 	. = ALIGN(4);
 	bhook_start = .;
 	*(bhook)
+	bhook_globals = .;
+	*(gbhook)
 	bhook_end = .;
 	. = ALIGN(4);
 	ehook_start = .;
+	*(gehook)
+	ehook_globals = .;
 	*(ehook)
 	ehook_end = .;
 EOF
@@ -1906,6 +1906,11 @@ expand_call (exp, target, ignore)
      INIT_CUMULATIVE_ARGS tells the backend if this is an indirect call
      or not.  */
   INIT_CUMULATIVE_ARGS (args_so_far, funtype, NULL_RTX, (fndecl == 0));
+#ifdef INIT_CUMULATIVE_ARGS_FNDECL
+  /* Some targets choose a calling convention for particular functions,
+     rather than for their types.  FNDECL is 0 for an indirect call.  */
+  INIT_CUMULATIVE_ARGS_FNDECL (args_so_far, fndecl);
+#endif
 
   /* If struct_value_rtx is 0, it means pass the address
      as if it were an extra parameter.  */
@@ -299,33 +299,59 @@ SYM (__mulsi3):
 	rts
 #endif /* L_mulsi3 */
 
+/* The division routines return the remainder in d1 as well as the
+   quotient in d0, so __umodsi3 and __modsi3 need no multiplication, and
+   libc's ldiv gets both results from a single call to __divsi3.  d2 is a
+   scratch register in the Palm OS calling convention, so it isn't saved.  */
+
 #ifdef  L_udivsi3
 	.text
 	.proc
 	.globl	SYM (__udivsi3)
 SYM (__udivsi3):
-	movel	d2, sp@-
-	movel	sp@(12), d1	/* d1 = divisor */
-	movel	sp@(8), d0	/* d0 = dividend */
+	movel	sp@(8), d1	/* d1 = divisor */
+	movel	sp@(4), d0	/* d0 = dividend */
 
 	cmpl	IMM (0x10000), d1 /* divisor >= 2 ^ 16 ?   */
 	jcc	L3		/* then try next algorithm */
 	movel	d0, d2
 	clrw	d2
-	swap	d2
-	divu	d1, d2          /* high quotient in lower word */
+	swap	d2		/* d2 = high dividend */
+	cmpw	d1, d2		/* will the quotient fit in 16 bits? */
+	jcc	L2
+	divu	d1, d0		/* then one divu does it */
+	movel	d0, d1
+	clrw	d1
+	swap	d1		/* d1 = remainder */
+	andl	IMM (0xffff), d0
+	rts
+
+L2:	divu	d1, d2          /* high quotient in lower word */
 	movew	d2, d0		/* save high quotient */
 	swap	d0
-	movew	sp@(10), d2	/* get low dividend + high rest */
+	movew	sp@(6), d2	/* get low dividend + high rest */
 	divu	d1, d2		/* low quotient */
 	movew	d2, d0
-	jra	L6
+	clrw	d2
+	swap	d2
+	movel	d2, d1		/* d1 = remainder */
+	rts
+
+L3:	cmpl	d1, d0		/* dividend < divisor ? */
+	jcc	L4
+	movel	d0, d1		/* then the quotient is 0 */
+	moveq	IMM (0), d0
+	rts
 
-L3:	movel	d1, d2		/* use d2 as divisor backup */
-L4:	lsrl	IMM (1), d1	/* shift divisor */
+L4:	movel	d1, d2		/* use d2 as divisor backup */
+	cmpl	IMM (0x1000000), d1 /* divisor >= 2 ^ 24 ? */
+	jcs	L5
+	lsrl	IMM (8), d1	/* then shift a byte at once */
+	lsrl	IMM (8), d0
+L5:	lsrl	IMM (1), d1	/* shift divisor */
 	lsrl	IMM (1), d0	/* shift dividend */
 	cmpl	IMM (0x10000), d1 /* still divisor >= 2 ^ 16 ?  */
-	jcc	L4
+	jcc	L5
 	divu	d1, d0		/* now we have 16 bit divisor */
 	andl	IMM (0xffff), d0 /* mask out divisor, ignore remainder */
 
@@ -338,14 +364,26 @@ L4:	lsrl	IMM (1), d1	/* shift divisor */
 	mulu	d0, d2		/* high part, at most 17 bits */
 	swap	d2		/* align high part with low part */
 	btst	IMM (0), d2	/* high part 17 bits? */
-	jne	L5		/* if 17 bits, quotient was too large */
+	jne	L6		/* if 17 bits, quotient was too large */
 	addl	d2, d1		/* add parts */
-	jcs	L5		/* if sum is 33 bits, quotient was too large */
-	cmpl	sp@(8), d1	/* compare the sum with the dividend */
-	jls	L6		/* if sum > dividend, quotient was too large */
-L5:	subql	IMM (1), d0	/* adjust quotient */
+	jcs	L6		/* if sum is 33 bits, quotient was too large */
+	movel	sp@(4), d2
+	subl	d1, d2		/* subtract the sum from the dividend */
+	jcs	L6		/* if sum > dividend, quotient was too large */
+	movel	d2, d1		/* d1 = remainder */
+	rts
 
-L6:	movel	sp@+, d2
+L6:	subql	IMM (1), d0	/* adjust quotient */
+	movel	sp@(8), d2	/* and multiply again for the remainder */
+	movel	d2, d1
+	mulu	d0, d1
+	swap	d2
+	mulu	d0, d2
+	swap	d2
+	clrw	d2
+	addl	d2, d1		/* d1 = quotient * divisor */
+	subl	sp@(4), d1
+	negl	d1		/* d1 = remainder */
 	rts
 #endif /* L_udivsi3 */
 
@@ -354,29 +392,26 @@ L6:	movel	sp@+, d2
 	.proc
 	.globl	SYM (__divsi3)
 SYM (__divsi3):
-	movel	d2, sp@-
-
-	moveb	IMM (1), d2	/* sign of result stored in d2 (=1 or =-1) */
-	movel	sp@(12), d1	/* d1 = divisor */
+	movel	sp@(8), d1	/* d1 = divisor */
 	jpl	L1
 	negl	d1
-	negb	d2		/* change sign because divisor <0  */
-L1:	movel	sp@(8), d0	/* d0 = dividend */
+L1:	movel	sp@(4), d0	/* d0 = dividend */
 	jpl	L2
 	negl	d0
-	negb	d2
 
 L2:	movel	d1, sp@-
 	movel	d0, sp@-
 	bsr	SYM (__udivsi3)	/* divide abs(dividend) by abs(divisor) */
 	addql	IMM (8), sp
 
-	tstb	d2
+	tstb	sp@(4)		/* the remainder has the dividend's sign */
 	jpl	L3
+	negl	d1
 	negl	d0
-
-L3:	movel	sp@+, d2
-	rts
+L3:	tstb	sp@(8)		/* and the quotient is negated again */
+	jpl	L4		/* if the divisor is negative */
+	negl	d0
+L4:	rts
 #endif /* L_divsi3 */
 
 #ifdef  L_umodsi3
@@ -384,20 +419,11 @@ L3:	movel	sp@+, d2
 	.proc
 	.globl	SYM (__umodsi3)
 SYM (__umodsi3):
-	movel	sp@(8), d1	/* d1 = divisor */
-	movel	sp@(4), d0	/* d0 = dividend */
-	movel	d1, sp@-
-	movel	d0, sp@-
+	movel	sp@(8), sp@-	/* divisor */
+	movel	sp@(8), sp@-	/* dividend */
 	bsr	SYM (__udivsi3)
 	addql	IMM (8), sp
-	movel	sp@(8), d1	/* d1 = divisor */
-	movel	d1, sp@-
-	movel	d0, sp@-
-	bsr	SYM (__mulsi3)	/* d0 = (a/b)*b */
-	addql	IMM (8), sp
-	movel	sp@(4), d1	/* d1 = dividend */
-	subl	d0, d1		/* d1 = a - (a/b)*b */
-	movel	d1, d0
+	movel	d1, d0		/* d0 = remainder */
 	rts
 #endif /* L_umodsi3 */
 
@@ -406,23 +432,88 @@ SYM (__umodsi3):
 	.proc
 	.globl	SYM (__modsi3)
 SYM (__modsi3):
-	movel	sp@(8), d1	/* d1 = divisor */
-	movel	sp@(4), d0	/* d0 = dividend */
-	movel	d1, sp@-
-	movel	d0, sp@-
+	movel	sp@(8), sp@-	/* divisor */
+	movel	sp@(8), sp@-	/* dividend */
 	bsr	SYM (__divsi3)
 	addql	IMM (8), sp
-	movel	sp@(8), d1	/* d1 = divisor */
-	movel	d1, sp@-
-	movel	d0, sp@-
-	bsr	SYM (__mulsi3)	/* d0 = (a/b)*b */
-	addql	IMM (8), sp
-	movel	sp@(4), d1	/* d1 = dividend */
-	subl	d0, d1		/* d1 = a - (a/b)*b */
-	movel	d1, d0
+	movel	d1, d0		/* d0 = remainder */
 	rts
 #endif /* L_modsi3 */
 
+#ifdef  L_udiv_qrnnd
+/* USItype __udiv_qrnnd (USItype *rp, USItype n1, USItype n0, USItype d)
+   divides the 64 bit n1:n0 by d, returning the quotient and storing the
+   remainder at *rp.  d must be normalized (its top bit set) and n1 < d.
+   This is longlong.h's __udiv_qrnnd_c with each 32/16 bit step done by a
+   single divu; libgcc2's 64 bit division uses it via udiv_qrnnd.  */
+	.text
+	.proc
+	.globl	SYM (__udiv_qrnnd)
+SYM (__udiv_qrnnd):
+	moveml	d3-d4, sp@-
+	movel	sp@(24), d3	/* d3 = divisor */
+	movel	d3, d4
+	swap	d4		/* d4.w = high divisor */
+	movel	sp@(16), d1	/* d1 = n1 */
+	movew	sp@(20), d2	/* next digit: high half of n0 */
+	bsr	L1
+	movel	d0, a1		/* save high quotient */
+	movew	sp@(22), d2	/* next digit: low half of n0 */
+	bsr	L1
+	movel	a1, d2
+	swap	d2
+	movew	d0, d2		/* d2 = quotient */
+	movel	sp@(12), a0
+	movel	d1, a0@		/* store remainder */
+	movel	d2, d0
+	moveml	sp@+, d3-d4
+	rts
+
+/* Divide d1 * 2^16 + d2.w by d3, given d1 < d3: quotient digit to d0,
+   remainder to d1.  The digit is estimated by dividing d1 by the high
+   half of the divisor, and is at most two too large.  */
+L1:	movel	d1, d0
+	swap	d0
+	cmpw	d4, d0		/* would the estimate overflow? */
+	jcc	L3
+	movel	d1, d0
+	divu	d4, d0		/* d0 = remainder : estimate */
+	movel	d0, d1
+	movew	d2, d1		/* d1 = remainder * 2^16 + next digit */
+	andl	IMM (0xffff), d0
+	movew	d3, d2
+	mulu	d0, d2		/* d2 = estimate * low divisor */
+L2:	subl	d2, d1
+	jcc	L4		/* if it went negative, the estimate */
+	subql	IMM (1), d0	/* was too large */
+	addl	d3, d1
+	jcs	L4		/* carry means it's positive again */
+	subql	IMM (1), d0
+	addl	d3, d1
+	rts
+
+/* The high half of d1 equals that of the divisor, so the estimate is
+   0xffff and the remainder from it is the low half of d1 plus the high
+   half of the divisor.  If that doesn't fit in 16 bits, the estimate is
+   exact and the result only needs computing modulo 2^32.  */
+L3:	moveq	IMM (0), d0
+	notw	d0
+	addw	d4, d1
+	jcs	L5
+	swap	d1
+	movew	d2, d1
+	movew	d3, d2
+	mulu	d0, d2
+	jra	L2
+
+L5:	swap	d1
+	movew	d2, d1
+	movew	d3, d2
+	mulu	d0, d2
+	subl	d2, d1
+L4:	rts
+#endif /* L_udiv_qrnnd */
+
 
 #ifdef  L_double
 
@@ -2753,6 +2844,531 @@ Lround$to$minus:
 	jmp	a0@
 #endif /* L_float */
 
+#ifdef  L_fastsf
+
+| Single precision add, subtract, multiply, divide, negate and compare
+| routines for -mfast-float, which makes gcc call these __fast_* names
+| instead of the L_float ones.  They always round to nearest and they
+| neither read nor update _fpCCR, so they never call the exception
+| handler and need no global data.  Their results are correctly rounded,
+| including the signed zeros, NaN comparisons and overflows that L_float
+| gets wrong; prc-tools checks them against the host with floattst.c.
+| They are quicker because the common case of normalized operands and
+| results runs straight through without a frame or special case tests,
+| leading zeros are counted with a table rather than a shifting loop,
+| significands are multiplied with four mulu instructions rather than a
+| 24 step loop, and divided with two divu steps rather than a 26 step
+| loop.
+|
+| add, mul and div build up their result as
+|   d0    the significand, with its leading one in bit 30, followed by 23
+|         more bits, a rounding bit (bit 6) and 6 sticky bits
+|   d2.w  its biased exponent, which may be out of range
+|   a1    whose bit 31 is its sign
+| and then go to Lfast$pack to round it and return.  They save d3-d5.
+
+	QUIET_NaN	= -1
+	INFINITY	= 0x7f800000
+
+	.text
+	.proc
+	.globl	SYM (__fast_addsf3)
+	.globl	SYM (__fast_subsf3)
+	.globl	SYM (__fast_mulsf3)
+	.globl	SYM (__fast_divsf3)
+	.globl	SYM (__fast_negsf2)
+	.globl	SYM (__fast_eqsf2)
+	.globl	SYM (__fast_nesf2)
+	.globl	SYM (__fast_gtsf2)
+	.globl	SYM (__fast_gesf2)
+	.globl	SYM (__fast_ltsf2)
+	.globl	SYM (__fast_lesf2)
+
+SYM (__fast_subsf3):
+	movel	sp@(8),d1
+	bchg	IMM (31),d1		| a - b = a + -b
+	bra	1f
+SYM (__fast_addsf3):
+	movel	sp@(8),d1
+1:	movel	sp@(4),d0
+	moveml	d3-d5,sp@-
+	movel	d0,d2
+	addl	d2,d2			| d2 = 2|a|
+	movel	d1,d3
+	addl	d3,d3			| d3 = 2|b|
+	cmpl	d3,d2
+	bcc	2f
+	exg	d0,d1			| make |a| >= |b|
+	exg	d2,d3
+2:	movel	d0,a1			| the sum has the sign of a
+	eorl	d0,d1
+	movel	d1,a0			| bit 31 set: subtract the magnitudes
+	movel	d2,d0
+	movel	d3,d1
+	swap	d2
+	lsrw	IMM (8),d2		| d2 = exponent of a
+	swap	d3
+	lsrw	IMM (8),d3		| d3 = exponent of b
+	cmpw	IMM (0xff),d2
+	beq	Laddsf$inf
+	tstw	d3
+	beq	Laddsf$small
+	lsll	IMM (7),d0
+	bset	IMM (31),d0
+	lsrl	IMM (1),d0		| d0 = significand of a
+	lsll	IMM (7),d1
+	bset	IMM (31),d1
+	lsrl	IMM (1),d1		| d1 = significand of b
+Laddsf$align:
+	negw	d3
+	addw	d2,d3			| d3 = difference of the exponents
+	beq	Laddsf$add
+	cmpw	IMM (7),d3
+	bhi	3f
+	lsrl	d3,d1			| only the 7 zero bits below b fall off
+	bra	Laddsf$add
+3:	cmpw	IMM (26),d3
+	bcc	4f
+	movel	d1,d4
+	lsrl	d3,d1			| line b up with a...
+	movel	d1,d5
+	lsll	d3,d5
+	cmpl	d5,d4
+	beq	Laddsf$add
+	orb	IMM (1),d1		| ...keeping what falls off as a sticky bit
+	bra	Laddsf$add
+4:	moveq	IMM (1),d1		| b is too small to be more than that
+Laddsf$add:
+	movel	a0,d4
+	bmi	Laddsf$sub
+	addl	d1,d0
+	bpl	Lfast$pack
+	lsrl	IMM (1),d0		| the sum carried into bit 31
+	bcc	5f
+	orb	IMM (1),d0
+5:	addqw	IMM (1),d2
+	bra	Lfast$pack
+Laddsf$sub:
+	subl	d1,d0
+	beq	Lfast$ret		| an exact zero is +0
+	btst	IMM (30),d0
+	bne	Lfast$pack
+	movel	d0,d4			| renormalize after cancellation
+	bsr	Lfast$norm
+	movel	d4,d0
+	lsrl	IMM (1),d0
+	subqw	IMM (1),d5
+	subw	d5,d2
+	bra	Lfast$pack
+
+Laddsf$small:
+	tstl	d1
+	beq	Laddsf$zero
+	tstw	d2
+	beq	Laddsf$denormals
+	lsll	IMM (7),d0
+	bset	IMM (31),d0
+	lsrl	IMM (1),d0
+	lsll	IMM (6),d1		| a denormal b has no hidden bit,
+	moveq	IMM (1),d3		| and the exponent of the smallest normal
+	bra	Laddsf$align
+Laddsf$zero:
+	tstl	d0
+	bne	6f			| a + 0 = a
+	movel	a0,d4
+	bmi	Lfast$ret		| +0 + -0 = +0
+6:	movel	a1,d0
+	bra	Lfast$ret
+Laddsf$denormals:
+	lsrl	IMM (1),d0		| these add as integers, carrying into the
+	lsrl	IMM (1),d1		| exponent if the sum is normalized
+	movel	a0,d4
+	bmi	7f
+	addl	d1,d0
+	bra	Lfast$sign
+7:	subl	d1,d0
+	beq	Lfast$ret
+	bra	Lfast$sign
+Laddsf$inf:
+	cmpl	IMM (0xff000000),d0
+	bhi	Lfast$nan
+	cmpl	d0,d1
+	bne	8f
+	movel	a0,d4
+	bmi	Lfast$nan		| inf - inf
+8:	movel	a1,d0
+	bra	Lfast$ret
+
+SYM (__fast_mulsf3):
+	movel	sp@(4),d0
+	movel	sp@(8),d1
+	moveml	d3-d5,sp@-
+	movel	d0,d2
+	eorl	d1,d2
+	movel	d2,a1			| the sign of the product
+	movel	d0,d2
+	addl	d2,d2
+	swap	d2
+	lsrw	IMM (8),d2		| d2 = exponent of a
+	movel	d1,d3
+	addl	d3,d3
+	swap	d3
+	lsrw	IMM (8),d3		| d3 = exponent of b
+	movew	d2,d4
+	subqw	IMM (1),d4
+	cmpw	IMM (0xfd),d4
+	bhi	Lmulsf$special		| a is zero, denormal, inf or NaN
+	movew	d3,d4
+	subqw	IMM (1),d4
+	cmpw	IMM (0xfd),d4
+	bhi	Lmulsf$special		| so is b
+	lsll	IMM (8),d0
+	bset	IMM (31),d0		| d0 = significand of a, in the top 24 bits
+	lsll	IMM (8),d1
+	bset	IMM (31),d1		| d1 = significand of b
+Lmulsf$1:
+	addw	d3,d2
+	subw	IMM (127),d2
+	movel	d0,d3
+	mulu	d1,d3			| low a * low b: only its top half counts
+	clrw	d3
+	swap	d3
+	movel	d0,d4
+	swap	d4
+	mulu	d1,d4			| high a * low b
+	addl	d4,d3
+	swap	d1
+	movel	d0,d4
+	mulu	d1,d4			| low a * high b
+	swap	d0
+	mulu	d1,d0			| high a * high b
+	addl	d4,d3			| X = the carry from the middle terms
+	movew	d3,d4			| d4.w = the bits below d0, all sticky
+	moveq	IMM (0),d1
+	clrw	d3
+	addxw	d1,d3
+	swap	d3
+	addl	d3,d0			| d0 = top 32 bits of the product
+	tstw	d4
+	beq	1f
+	orb	IMM (1),d0
+1:	tstl	d0
+	bpl	Lfast$pack
+	lsrl	IMM (1),d0		| the product is 2 or more
+	bcc	2f
+	orb	IMM (1),d0
+2:	addqw	IMM (1),d2
+	bra	Lfast$pack
+
+Lmulsf$special:
+	movel	d0,d4
+	addl	d4,d4			| d4 = 2|a|
+	movel	d1,d5
+	addl	d5,d5			| d5 = 2|b|
+	cmpl	IMM (0xff000000),d4
+	bhi	Lfast$nan
+	cmpl	IMM (0xff000000),d5
+	bhi	Lfast$nan
+	beq	3f
+	cmpl	IMM (0xff000000),d4
+	beq	4f
+	tstl	d4
+	beq	Lfast$zero
+	tstl	d5
+	beq	Lfast$zero
+	bsr	Lfast$unpack		| one or both are denormal
+	bra	Lmulsf$1
+3:	exg	d4,d5			| b is inf
+4:	tstl	d5			| a is inf
+	beq	Lfast$nan		| inf * 0
+	bra	Lfast$inf
+
+SYM (__fast_divsf3):
+	movel	sp@(4),d0
+	movel	sp@(8),d1
+	moveml	d3-d5,sp@-
+	movel	d0,d2
+	eorl	d1,d2
+	movel	d2,a1			| the sign of the quotient
+	movel	d0,d2
+	addl	d2,d2
+	swap	d2
+	lsrw	IMM (8),d2		| d2 = exponent of a
+	movel	d1,d3
+	addl	d3,d3
+	swap	d3
+	lsrw	IMM (8),d3		| d3 = exponent of b
+	movew	d2,d4
+	subqw	IMM (1),d4
+	cmpw	IMM (0xfd),d4
+	bhi	Ldivsf$special		| a is zero, denormal, inf or NaN
+	movew	d3,d4
+	subqw	IMM (1),d4
+	cmpw	IMM (0xfd),d4
+	bhi	Ldivsf$special		| so is b
+	lsll	IMM (8),d0
+	bset	IMM (31),d0		| d0 = significand of a, in the top 24 bits
+	lsll	IMM (8),d1
+	bset	IMM (31),d1		| d1 = significand of b
+Ldivsf$1:
+	lsrl	IMM (1),d0		| make the dividend less than the divisor
+	subw	d3,d2
+	addw	IMM (126),d2
+	movel	d1,a0			| a0 = divisor
+	movel	d1,d3
+	swap	d3			| d3.w = its high half
+	movew	d1,d4			| d4.w = its low half
+	bsr	Ldivsf$digit
+	swap	d2
+	movew	d0,d2			| keep the high quotient in the top of d2
+	swap	d2
+	movel	d1,d0
+	bsr	Ldivsf$digit
+	swap	d0
+	swap	d2
+	movew	d2,d0
+	swap	d2
+	swap	d0			| d0 = 32 bit quotient
+	tstl	d1
+	beq	1f
+	orb	IMM (1),d0		| the remainder is sticky
+1:	tstl	d0
+	bpl	Lfast$pack
+	lsrl	IMM (1),d0		| the quotient is 1 or more
+	bcc	2f
+	orb	IMM (1),d0
+2:	addqw	IMM (1),d2
+	bra	Lfast$pack
+
+| Divide d0, which is less than the divisor, times 2^16 by the divisor:
+| return the quotient in d0.w and the remainder in d1.  The quotient is
+| estimated with divu from the high half of the divisor, then corrected
+| as in Algorithm D of Knuth; the estimate is at most 2 too big.
+Ldivsf$digit:
+	movel	d0,d5
+	swap	d5
+	cmpw	d3,d5
+	bcc	5f			| divu would overflow
+	divu	d3,d0
+	movel	d0,d5
+	mulu	d4,d5			| estimate * low half of the divisor
+	movel	d0,d1
+	clrw	d1
+	subl	d5,d1			| the remainder, if the estimate is right
+	bcc	4f
+3:	subqw	IMM (1),d0
+	addl	a0,d1
+	bcc	3b
+4:	rts
+5:	movew	d4,d5			| estimate 0xffff, the remainder being
+	subw	d0,d5			| divisor - (divisor - d0) * 2^16
+	swap	d5
+	clrw	d5
+	movel	a0,d1
+	moveq	IMM (-1),d0
+	subl	d5,d1
+	bcc	4b
+	bra	3b
+
+Ldivsf$special:
+	movel	d0,d4
+	addl	d4,d4			| d4 = 2|a|
+	movel	d1,d5
+	addl	d5,d5			| d5 = 2|b|
+	cmpl	IMM (0xff000000),d4
+	bhi	Lfast$nan
+	cmpl	IMM (0xff000000),d5
+	bhi	Lfast$nan
+	cmpl	IMM (0xff000000),d4
+	bne	6f
+	cmpl	d4,d5
+	beq	Lfast$nan		| inf / inf
+	bra	Lfast$inf
+6:	cmpl	IMM (0xff000000),d5
+	beq	Lfast$zero		| x / inf
+	tstl	d5
+	bne	7f
+	tstl	d4
+	beq	Lfast$nan		| 0 / 0
+	bra	Lfast$inf		| x / 0
+7:	tstl	d4
+	beq	Lfast$zero
+	bsr	Lfast$unpack		| one or both are denormal
+	bra	Ldivsf$1
+
+| Round the result to nearest even, pack it and return.  A carry out of
+| the significand when rounding up bumps the exponent, to infinity if
+| need be.
+Lfast$pack:
+	cmpw	IMM (0xfe),d2
+	bgt	Lfast$inf		| overflow
+	tstw	d2
+	ble	Lfast$tiny		| denormal, or underflow to zero
+Lfast$round:
+	btst	IMM (7),d0
+	beq	1f
+	addql	IMM (1),d0		| rounding halfway cases to even...
+1:	moveq	IMM (0x3f),d1
+	addl	d1,d0			| ...and others to nearest
+	lsrl	IMM (7),d0
+	subqw	IMM (1),d2
+	swap	d2
+	clrw	d2
+	lsll	IMM (7),d2
+	addl	d2,d0			| add the exponent to the hidden bit
+Lfast$sign:
+	movel	a1,d1
+	bpl	Lfast$ret
+	bset	IMM (31),d0
+Lfast$ret:
+	moveml	sp@+,d3-d5
+	rts
+Lfast$tiny:
+	negw	d2
+	addqw	IMM (1),d2		| d2 = places to shift the denormal
+	cmpw	IMM (31),d2
+	bcc	3f
+	movel	d0,d1
+	lsrl	d2,d1
+	movel	d1,a0
+	lsll	d2,d1
+	cmpl	d1,d0
+	exg	d0,a0			| (leaves the condition codes alone)
+	beq	2f
+	orb	IMM (1),d0		| keep what falls off as a sticky bit
+	bra	2f
+3:	moveq	IMM (1),d0		| nothing is left but the sticky bit
+2:	moveq	IMM (1),d2		| and the exponent field is 0
+	bra	Lfast$round
+Lfast$inf:
+	movel	IMM (INFINITY),d0
+	bra	Lfast$sign
+Lfast$zero:
+	moveq	IMM (0),d0
+	bra	Lfast$sign
+Lfast$nan:
+	moveq	IMM (QUIET_NaN),d0
+	bra	Lfast$ret
+
+| Give mul and div the significands of a and b in d0 and d1, with their
+| leading ones in bit 31, normalizing denormals and adjusting their
+| exponents in d2 and d3 to match.
+Lfast$unpack:
+	tstw	d2
+	bne	1f
+	movel	d0,d4
+	andl	IMM (0x7fffff),d4
+	bsr	Lfast$norm
+	movel	d4,d0
+	moveq	IMM (9),d2
+	subw	d5,d2
+	bra	2f
+1:	lsll	IMM (8),d0
+	bset	IMM (31),d0
+2:	tstw	d3
+	bne	3f
+	movel	d1,d4
+	andl	IMM (0x7fffff),d4
+	bsr	Lfast$norm
+	movel	d4,d1
+	moveq	IMM (9),d3
+	subw	d5,d3
+	rts
+3:	lsll	IMM (8),d1
+	bset	IMM (31),d1
+	rts
+
+| Shift d4, which must not be zero, left until its top bit is set, and
+| return the number of places in d5.
+Lfast$norm:
+	movel	d3,sp@-
+	moveq	IMM (0),d5
+	cmpl	IMM (0xffff),d4
+	bhi	1f
+	swap	d4
+	moveq	IMM (16),d5
+1:	cmpl	IMM (0xffffff),d4
+	bhi	2f
+	lsll	IMM (8),d4
+	addqw	IMM (8),d5
+2:	movel	d4,d3
+	roll	IMM (8),d3
+	andw	IMM (0xff),d3
+	moveb	Lfast$clz(%pc,d3:w),d3	| leading zeros in the top byte
+	lsll	d3,d4
+	addw	d3,d5
+	movel	sp@+,d3
+	rts
+
+Lfast$clz:
+	.byte	8,7,6,6,5,5,5,5,4,4,4,4,4,4,4,4
+	.byte	3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3
+	.byte	2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2
+	.byte	2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2
+	.byte	1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1
+	.byte	1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1
+	.byte	1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1
+	.byte	1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1
+	.byte	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
+	.byte	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
+	.byte	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
+	.byte	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
+	.byte	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
+	.byte	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
+	.byte	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
+	.byte	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
+	.even
+
+SYM (__fast_negsf2):
+	movel	sp@(4),d0
+	bchg	IMM (31),d0
+	rts
+
+| The comparisons return -1, 0 or 1 as a < b, a == b or a > b, or if
+| either is a NaN, a value that makes the test false: 1 for the eq, ne,
+| lt and le routines and -1 for the gt and ge ones.  They turn each
+| operand into a signed integer with the same ordering (+0 and -0 both
+| becoming 0) and compare those.
+SYM (__fast_gtsf2):
+SYM (__fast_gesf2):
+	moveq	IMM (-1),d2
+	bra	1f
+SYM (__fast_eqsf2):
+SYM (__fast_nesf2):
+SYM (__fast_ltsf2):
+SYM (__fast_lesf2):
+	moveq	IMM (1),d2		| the result for a NaN
+1:	movel	sp@(4),d0
+	bclr	IMM (31),d0
+	beq	2f
+	cmpl	IMM (INFINITY),d0
+	bhi	6f
+	negl	d0
+	bra	3f
+2:	cmpl	IMM (INFINITY),d0
+	bhi	6f
+3:	movel	sp@(8),d1
+	bclr	IMM (31),d1
+	beq	4f
+	cmpl	IMM (INFINITY),d1
+	bhi	6f
+	negl	d1
+	bra	5f
+4:	cmpl	IMM (INFINITY),d1
+	bhi	6f
+5:	cmpl	d1,d0
+	blt	7f
+	bgt	8f
+	moveq	IMM (0),d0
+	rts
+6:	movel	d2,d0
+	rts
+7:	moveq	IMM (-1),d0
+	rts
+8:	moveq	IMM (1),d0
+	rts
+#endif /* L_fastsf */
+
 | gcc expects the routines __eqdf2, __nedf2, __gtdf2, __gedf2,
 | __ledf2, __ltdf2 to all return the same value as a direct call to
 | __cmpdf2 would.  In this implementation, each of these routines
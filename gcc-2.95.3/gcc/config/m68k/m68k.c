@@ -34,6 +34,7 @@ Boston, MA 02111-1307, USA.  */
 #include "insn-attr.h"
 #include "recog.h"
 #include "toplev.h"
+#include "expr.h"
 
 /* Needed for use_return_insn.  */
 #include "flags.h"
@@ -124,6 +125,20 @@ override_options ()
     }
   else
     m68k_align_funcs = def_align;
+
+#ifdef PALMOS
+  /* Validate -mregparm= value.  Functions' addresses are only redirected
+     to their stack argument entry points with -mpcrel, and the profiler
+     calls in the prologue would clobber the argument registers.  */
+  if (palmos_regparm_string)
+    {
+      palmos_regparm = atoi (palmos_regparm_string);
+      if (palmos_regparm < 0 || palmos_regparm > 5)
+	fatal ("-mregparm=%d is not between 0 and 5", palmos_regparm);
+    }
+  if (! TARGET_PCREL || profile_flag || profile_block_flag)
+    palmos_regparm = 0;
+#endif
 }
 
 #ifdef PALMOS
@@ -131,6 +146,12 @@ override_options ()
    `PIC_OFFSET_TABLE_REGNUM' or `pic_offset_table_rtx'.  */
 int palmos_pic_reg;
 
+/* The maximum number of arguments passed in registers (-mregparm=N), and
+   the FUNCTION_DECLs of the functions taking arguments that way.  */
+const char *palmos_regparm_string;
+int palmos_regparm;
+static tree regparm_functions;
+
 #define TREE_LIST_CDR(NODE) \
   ((NODE != NULL_TREE)? TREE_CHAIN (NODE) : NULL_TREE)
 
@@ -301,6 +322,130 @@ palmos_valid_machine_decl_attribute (decl, attributes, attr, args)
 }
 
 
+/* Return a pointer to the `%|' component of the encoded symbol NAME, if
+   it has one, i.e., if it is the name of a function taking register
+   arguments.  */
+static char *
+regparm_prefix (name)
+     char *name;
+{
+  while (*name == '*' || *name == '=' || *name == '@' || *name == '%')
+    {
+      if (*name == '%')
+	return name;
+      if (*name != '*')
+	while (*name != '\036')
+	  name++;
+      name++;
+    }
+
+  return NULL;
+}
+
+int
+palmos_regparm_name_p (name)
+     char *name;
+{
+  return regparm_prefix (name) != NULL;
+}
+
+/* Return nonzero if direct calls to DECL pass its arguments in registers.  */
+int
+palmos_regparm_decl_p (decl)
+     tree decl;
+{
+  rtx rtl = DECL_RTL (decl);
+
+  return (rtl != NULL_RTX && GET_CODE (rtl) == MEM
+	  && GET_CODE (XEXP (rtl, 0)) == SYMBOL_REF
+	  && palmos_regparm_name_p (XSTR (XEXP (rtl, 0), 0)));
+}
+
+/* Return the number of the register in which to pass the next argument,
+   of mode MODE and type TYPE, given the arguments CUM already scanned, or
+   -1 if it should be pushed on the stack.  */
+int
+palmos_arg_regno (cum, mode, type)
+     struct palmos_args *cum;
+     enum machine_mode mode;
+     tree type;
+{
+  int size = GET_MODE_SIZE (mode);
+
+  if (cum->dregs + cum->aregs >= cum->nregs
+      || mode == VOIDmode || mode == BLKmode || size > 4
+      || type == NULL_TREE
+      || ! (INTEGRAL_TYPE_P (type) || POINTER_TYPE_P (type)
+	    || TREE_CODE (type) == REAL_TYPE))
+    return -1;
+
+  if (POINTER_TYPE_P (type) && cum->aregs < 2)
+    return 8 + cum->aregs;
+  else if (cum->dregs < 3)
+    return cum->dregs;
+  else if (size > 1 && cum->aregs < 2)
+    return 8 + cum->aregs;
+  else
+    return -1;
+}
+
+rtx
+palmos_function_arg (cum, mode, type)
+     struct palmos_args *cum;
+     enum machine_mode mode;
+     tree type;
+{
+  int regno = palmos_arg_regno (cum, mode, type);
+
+  return (regno >= 0)? gen_rtx_REG (mode, regno) : NULL_RTX;
+}
+
+/* Return nonzero if DECL, whose symbol's name is NAME, is a function that
+   can take its arguments in registers: one that's local to this file,
+   that has a prototype without an ellipsis, and all of whose arguments
+   fit in the registers available.  Nested functions, functions returning
+   structures, and ones with any of our calling sequence, prologue, or
+   epilogue attributes keep to the usual convention.  */
+static int
+regparm_eligible_p (decl, name)
+     tree decl;
+     char *name;
+{
+  tree type = TREE_TYPE (decl);
+  tree attrs = DECL_MACHINE_ATTRIBUTES (decl);
+  tree args;
+  struct palmos_args cum;
+
+  if (palmos_regparm == 0
+      || TREE_PUBLIC (decl)
+      || decl_function_context (decl) != NULL_TREE
+      || TREE_CODE (type) != FUNCTION_TYPE
+      || TYPE_ARG_TYPES (type) == NULL_TREE
+      || aggregate_value_p (TREE_TYPE (type))
+      || name[0] == '='
+      || lookup_attribute ("callseq", attrs)
+      || lookup_attribute ("extralogue", attrs)
+      || lookup_attribute ("owngp", attrs))
+    return 0;
+
+  cum.nregs = palmos_regparm;
+  cum.dregs = cum.aregs = 0;
+  for (args = TYPE_ARG_TYPES (type);
+       args != NULL_TREE && TREE_VALUE (args) != void_type_node;
+       args = TREE_CHAIN (args))
+    {
+      tree arg_type = TREE_VALUE (args);
+      enum machine_mode mode = TYPE_MODE (arg_type);
+
+      if (palmos_arg_regno (&cum, mode, arg_type) < 0)
+	return 0;
+      FUNCTION_ARG_ADVANCE (cum, mode, arg_type, 1);
+    }
+
+  /* A null ARGS means there was an ellipsis.  */
+  return args != NULL_TREE && cum.dregs + cum.aregs > 0;
+}
+
 /* Encode DECL's section name into SYM's name as `@section|symname'.  */
 /* @@@ JWM fix the comment */
 void
@@ -310,7 +455,7 @@ palmos_encode_section_info (sym, funcdecl, section_only)
      int section_only;
 {
   char *name, *section, *callseq;
-  int offset, section_offset, callseq_offset;
+  int offset, section_offset, callseq_offset, regparm;
   tree a;
 
   name = XSTR (XEXP (sym, 0), 0);
@@ -335,9 +480,29 @@ palmos_encode_section_info (sym, funcdecl, section_only)
   else
     callseq = NULL;
 
-  if (offset != 0)
+  /* Decide whether the function takes register arguments the first time
+     it's declared with a prototype, provided that nothing has yet been
+     compiled that would depend on the decision.  (A call that has been
+     expanded has marked it addressable.)  The `%|' goes after any
+     encodings already present but before a leading `*', which
+     assemble_name only understands at the start of the name.  */
+  regparm = (!section_only && callseq == NULL
+	     && ! palmos_regparm_name_p (name)
+	     && ! TREE_ADDRESSABLE (funcdecl) && ! TREE_ASM_WRITTEN (funcdecl)
+	     && DECL_SAVED_INSNS (funcdecl) == NULL_RTX
+	     && regparm_eligible_p (funcdecl, name));
+  if (regparm)
+    {
+      push_obstacks_nochange ();
+      end_temporary_allocation ();
+      regparm_functions = tree_cons (NULL_TREE, funcdecl, regparm_functions);
+      pop_obstacks ();
+    }
+
+  if (offset != 0 || regparm)
     {
-      char *newname = permalloc (offset + strlen (name) + 1);
+      char *newname = permalloc (offset + strlen (name) + 2 + 1);
+      char *real_name;
 
       if (section)
         sprintf (newname + section_offset, "@%s\036", section);
@@ -345,13 +510,121 @@ palmos_encode_section_info (sym, funcdecl, section_only)
       if (callseq)
         sprintf (newname + callseq_offset, "=%s\036", callseq);
 
-      sprintf (newname + offset, "%s", name);
+      STRIP_NAME_ENCODING (real_name, name);
+      while (real_name > name && real_name[-1] == '*')
+	real_name--;
+      sprintf (newname + offset, "%.*s%s%s", (int) (real_name - name), name,
+	       (regparm)? "%\036" : "", real_name);
 
       XSTR (XEXP (sym, 0), 0) = newname;
     }
 }
 
 
+/* Return a symbol for the entry point of the function taking register
+   arguments whose symbol is SYM, through which it can be called with its
+   arguments on the stack.  This entry point, named `func.stack', loads the
+   arguments into their registers and branches to the function.  */
+static rtx
+stack_entry_symbol (sym)
+     rtx sym;
+{
+  char *name = XSTR (sym, 0);
+  char *prefix = regparm_prefix (name);
+  char *real_name, *entry_name;
+  rtx entry;
+
+  /* Make sure the function itself is output even if it is inline, as its
+     own name might not otherwise appear in the assembly.  */
+  STRIP_NAME_ENCODING (real_name, name);
+  TREE_SYMBOL_REFERENCED (get_identifier (real_name)) = 1;
+
+  entry_name = alloca (strlen (name) + 6 + 1);
+  sprintf (entry_name, "%.*s%s.stack", (int) (prefix - name), name,
+	   prefix + 2);
+
+  /* Ensure the pointer is unique so that CSE will notice the similarity.  */
+  entry = gen_rtx_SYMBOL_REF (Pmode,
+			      IDENTIFIER_POINTER (get_identifier (entry_name)));
+  SYMBOL_REF_FLAG (entry) = 1;
+
+  /* Likewise create the identifier by which assemble_name will record
+     that the entry point has been used.  */
+  STRIP_NAME_ENCODING (real_name, XSTR (entry, 0));
+  get_identifier (real_name);
+
+  return entry;
+}
+
+/* Return the address to use for X, an address in initialized data.  */
+rtx
+palmos_stack_entry_address (x)
+     rtx x;
+{
+  if (GET_CODE (x) == SYMBOL_REF && palmos_regparm_name_p (XSTR (x, 0)))
+    return stack_entry_symbol (x);
+  else
+    return x;
+}
+
+/* Output the stack argument entry points of the functions taking register
+   arguments whose addresses have been used, each in its function's
+   section.  */
+void
+palmos_output_stack_entries (file)
+     FILE *file;
+{
+  tree link;
+
+  for (link = regparm_functions; link != NULL_TREE; link = TREE_CHAIN (link))
+    {
+      tree decl = TREE_VALUE (link);
+      char *name = XSTR (XEXP (DECL_RTL (decl), 0), 0);
+      char *real_name, *entry_name;
+      tree id, args;
+      struct palmos_args cum;
+      int offset;
+
+      STRIP_NAME_ENCODING (real_name, name);
+      entry_name = alloca (strlen (real_name) + 6 + 1);
+      sprintf (entry_name, "%s.stack", real_name);
+
+      id = maybe_get_identifier (entry_name);
+      if (! TREE_ASM_WRITTEN (decl) || id == NULL_TREE
+	  || ! TREE_SYMBOL_REFERENCED (id))
+	continue;
+
+      function_section (decl);
+      ASM_OUTPUT_ALIGN (file, 1);
+      ASM_OUTPUT_LABEL (file, entry_name);
+
+      /* The arguments are pushed as for any other function, each padded
+	 to PARM_BOUNDARY, above the return address.  */
+      cum.nregs = palmos_regparm;
+      cum.dregs = cum.aregs = 0;
+      offset = 4;
+      for (args = TYPE_ARG_TYPES (TREE_TYPE (decl));
+	   TREE_VALUE (args) != void_type_node;
+	   args = TREE_CHAIN (args))
+	{
+	  tree type = TREE_VALUE (args);
+	  enum machine_mode mode = TYPE_MODE (type);
+	  int size = GET_MODE_SIZE (mode);
+
+	  asm_fprintf (file, "\t%s %d(%Rsp),%s\n",
+		       (size == 1)? "move.b" : (size == 2)? "move.w" : "move.l",
+		       offset, reg_names[palmos_arg_regno (&cum, mode, type)]);
+	  FUNCTION_ARG_ADVANCE (cum, mode, type, 1);
+	  offset += (size + PARM_BOUNDARY / BITS_PER_UNIT - 1)
+		    & - (PARM_BOUNDARY / BITS_PER_UNIT);
+	}
+
+      fprintf (file, "\tbra.w ");
+      assemble_name (file, name);
+      fprintf (file, "\n");
+    }
+}
+
 static int
 section_differs_from_current_p (callee_name)
      char *callee_name;
@@ -468,6 +741,148 @@ output_callseq (operand1)
   app_disable ();
 }
 
+/* Return a library function symbol that issues New Float Manager trap
+   SELECTOR in place of a call to NAME, by encoding the trap sequence as
+   if NAME had been declared with a callseq attribute.  ARGSIZE is the size
+   of the arguments in bytes.  FIXUP, if non-null, is an instruction that
+   adjusts the result in %d0 after the trap.
+
+   If AUX is nonzero, the trap is one of the `_aux' functions, which store
+   a 64 bit result through a pointer passed before the arguments, as
+   CodeWarrior returns structures.  The arguments have already been pushed
+   when the sequence starts, so it copies them below an 8 byte temporary,
+   pushes the temporary's address, and pops the result into %d0/%d1 as GCC
+   expects.  */
+static rtx
+nfm_libfunc (name, selector, argsize, aux, fixup)
+     char *name;
+     int selector;
+     int argsize;
+     int aux;
+     char *fixup;
+{
+  char seq[320];
+  char *regs, *encoded;
+
+  seq[0] = '\0';
+  if (aux)
+    {
+      regs = (argsize == 4)? "%%d0"
+	     : (argsize == 8)? "%%d0-%%d1" : "%%d0-%%d1/%%a0-%%a1";
+      sprintf (seq, "%s (%%%%sp),%s; subq.l #8,%%%%sp; %s %s,-(%%%%sp); "
+		    "pea %d(%%%%sp); ",
+	       (argsize == 4)? "move.l" : "movem.l", regs,
+	       (argsize == 4)? "move.l" : "movem.l", regs, argsize);
+    }
+
+  sprintf (seq + strlen (seq), "moveq #%d,%%%%d2; trap #15; dc.w 0xA306",
+	   selector);
+
+  if (aux)
+    sprintf (seq + strlen (seq), "; lea %d(%%%%sp),%%%%sp; "
+	     "move.l (%%%%sp)+,%%%%d0; move.l (%%%%sp)+,%%%%d1", argsize + 4);
+  else if (fixup)
+    sprintf (seq + strlen (seq), "; %s", fixup);
+
+  encoded = permalloc (1 + strlen (seq) + 1 + strlen (name) + 1);
+  sprintf (encoded, "=%s\036%s", seq, name);
+  return gen_rtx_SYMBOL_REF (Pmode, encoded);
+}
+
+/* Implement -mnfm-inline: make the library calls for floating point
+   operations issue the corresponding New Float Manager traps directly,
+   rather than calling the wrappers in libnfm.a, which issue them in turn.
+   The comparisons use the NFM's boolean comparison traps, whose 1 or 0
+   results are adjusted to the signs the __eqsf2 family returns.  */
+void
+palmos_init_nfm_libfuncs ()
+{
+  add_optab->handlers[(int) SFmode].libfunc
+    = nfm_libfunc ("__addsf3", 46, 8, 0, NULL);
+  sub_optab->handlers[(int) SFmode].libfunc
+    = nfm_libfunc ("__subsf3", 48, 8, 0, NULL);
+  smul_optab->handlers[(int) SFmode].libfunc
+    = nfm_libfunc ("__mulsf3", 47, 8, 0, NULL);
+  flodiv_optab->handlers[(int) SFmode].libfunc
+    = nfm_libfunc ("__divsf3", 49, 8, 0, NULL);
+  neg_optab->handlers[(int) SFmode].libfunc
+    = nfm_libfunc ("__negsf2", 45, 4, 0, NULL);
+
+  add_optab->handlers[(int) DFmode].libfunc
+    = nfm_libfunc ("__adddf3", 51, 16, 1, NULL);
+  sub_optab->handlers[(int) DFmode].libfunc
+    = nfm_libfunc ("__subdf3", 53, 16, 1, NULL);
+  smul_optab->handlers[(int) DFmode].libfunc
+    = nfm_libfunc ("__muldf3", 52, 16, 1, NULL);
+  flodiv_optab->handlers[(int) DFmode].libfunc
+    = nfm_libfunc ("__divdf3", 54, 16, 1, NULL);
+  neg_optab->handlers[(int) DFmode].libfunc
+    = nfm_libfunc ("__negdf2", 50, 8, 1, NULL);
+
+  floatsisf_libfunc = nfm_libfunc ("__floatsisf", 4, 4, 0, NULL);
+  floatdisf_libfunc = nfm_libfunc ("__floatdisf", 6, 8, 0, NULL);
+  floatsidf_libfunc = nfm_libfunc ("__floatsidf", 8, 4, 1, NULL);
+  floatdidf_libfunc = nfm_libfunc ("__floatdidf", 10, 8, 1, NULL);
+  extendsfdf2_libfunc = nfm_libfunc ("__extendsfdf2", 11, 4, 1, NULL);
+  truncdfsf2_libfunc = nfm_libfunc ("__truncdfsf2", 12, 8, 0, NULL);
+  fixunssfsi_libfunc = nfm_libfunc ("__fixunssfsi", 17, 4, 0, NULL);
+  fixsfsi_libfunc = nfm_libfunc ("__fixsfsi", 18, 4, 0, NULL);
+  fixunssfdi_libfunc = nfm_libfunc ("__fixunssfdi", 19, 4, 1, NULL);
+  fixsfdi_libfunc = nfm_libfunc ("__fixsfdi", 20, 4, 1, NULL);
+  fixunsdfsi_libfunc = nfm_libfunc ("__fixunsdfsi", 21, 8, 0, NULL);
+  fixdfsi_libfunc = nfm_libfunc ("__fixdfsi", 22, 8, 0, NULL);
+  fixunsdfdi_libfunc = nfm_libfunc ("__fixunsdfdi", 23, 8, 1, NULL);
+  fixdfdi_libfunc = nfm_libfunc ("__fixdfdi", 24, 8, 1, NULL);
+
+  /* _f_feq and friends are selectors 27 to 32, and _d_feq and friends 37
+     to 42, in the order eq, ne, lt, le, gt, ge.  */
+  eqsf2_libfunc = nfm_libfunc ("__eqsf2", 27, 8, 0, "subq.l #1,%%d0");
+  nesf2_libfunc = nfm_libfunc ("__nesf2", 28, 8, 0, NULL);
+  ltsf2_libfunc = nfm_libfunc ("__ltsf2", 29, 8, 0, "neg.l %%d0");
+  lesf2_libfunc = nfm_libfunc ("__lesf2", 30, 8, 0, "eori.l #1,%%d0");
+  gtsf2_libfunc = nfm_libfunc ("__gtsf2", 31, 8, 0, NULL);
+  gesf2_libfunc = nfm_libfunc ("__gesf2", 32, 8, 0, "subq.l #1,%%d0");
+
+  eqdf2_libfunc = nfm_libfunc ("__eqdf2", 37, 16, 0, "subq.l #1,%%d0");
+  nedf2_libfunc = nfm_libfunc ("__nedf2", 38, 16, 0, NULL);
+  ltdf2_libfunc = nfm_libfunc ("__ltdf2", 39, 16, 0, "neg.l %%d0");
+  ledf2_libfunc = nfm_libfunc ("__ledf2", 40, 16, 0, "eori.l #1,%%d0");
+  gtdf2_libfunc = nfm_libfunc ("__gtdf2", 41, 16, 0, NULL);
+  gedf2_libfunc = nfm_libfunc ("__gedf2", 42, 16, 0, "subq.l #1,%%d0");
+}
+
+/* Output the -mlazy-sections load of a section's base address from its
+   `__text__SEC' variable, which is null until the section has been loaded.
+   In that case _GccLoadCodeSection loads it, preserving all registers; it
+   lives in the main section, so we can only bsr to it from there.  */
+char *
+output_lazy_section_base (operands)
+     rtx *operands;
+{
+  rtx xops[4];
+
+  xops[0] = operands[0];
+  xops[1] = operands[1];
+  xops[2] = gen_label_rtx ();
+  xops[3] = XEXP (operands[1], 0);
+
+  CC_STATUS_INIT;
+  output_asm_insn ("move.l %1,%0\n\tcmp.w %#0,%0\n\tjbne %l2\n\tpea %a3",
+		   xops);
+  if (DECL_SECTION_NAME (current_function_decl) == NULL_TREE)
+    output_asm_insn ("bsr.w _GccLoadCodeSection", xops);
+  else
+    {
+      xops[3] = gen_rtx_MEM (Pmode,
+			     gen_rtx_PLUS (SImode, pic_offset_table_rtx,
+					   gen_section_symbol_ref ("x")));
+      output_asm_insn ("move.l %3,%0\n\tjsr _GccLoadCodeSection(%0)", xops);
+    }
+  output_asm_insn ("addq.l %#4,%%sp\n\tmove.l %1,%0", xops);
+  ASM_OUTPUT_INTERNAL_LABEL (asm_out_file, "L", CODE_LABEL_NUMBER (xops[2]));
+  return "";
+}
+
 
 /* Output a MacsBug debugger symbol.  When SIZE is 0 and NAME is eight or
    sixteen chars, we could save a few bytes by using the old fixed-length
@@ -972,8 +1387,10 @@ output_function_epilogue (stream, size)
   if (insn && GET_CODE (insn) == BARRIER)
     {
       /* Output just a no-op so that debuggers don't get confused
-	 about which function the pc is in at this address.  */
-      asm_fprintf (stream, "\tnop\n");
+	 about which function the pc is in at this address.  That's
+	 not worth two bytes per function when optimizing for size.  */
+      if (! optimize_size)
+	asm_fprintf (stream, "\tnop\n");
       return;
     }
 
@@ -1099,12 +1516,13 @@ output_function_epilogue (stream, size)
 #endif
       fsize = 0, big = 1;
     }
-  if (TARGET_5200 || nregs <= 2)
+  if (TARGET_5200 || nregs <= ((optimize_size && ! restore_from_sp)? 1 : 2))
     {
       /* Restore each separately in the same order moveml does.
          Using two movel instructions instead of a single moveml
          is about 15% faster for the 68020 and 68030 at no expense
-         in code size. */
+         in code size -- except when they are relative to the frame
+         pointer, when a moveml is two bytes smaller.  */
 
       int i;
 
@@ -1855,6 +2273,14 @@ legitimize_pic_text_address (orig, calling)
     {
       char *name = XSTR (orig, 0);
 
+      /* The address of a function taking register arguments is that of
+	 its stack argument entry point, except when calling it directly.  */
+      if (! calling && palmos_regparm_name_p (name))
+	{
+	  orig = stack_entry_symbol (orig);
+	  name = XSTR (orig, 0);
+	}
+
       if (name[0] == '=')
 	{
 	  if (calling)
@@ -1880,7 +2306,14 @@ legitimize_pic_text_address (orig, calling)
 	  RTX_UNCHANGING_P (section_base) = 1;
 
 	  section_base_reg = gen_reg_rtx (Pmode);
-	  emit_move_insn (section_base_reg, section_base);
+	  /* The main section is always loaded.  */
+	  if (TARGET_LAZY_SECTIONS && name[0] == '@')
+	    emit_insn (gen_rtx_SET (VOIDmode, section_base_reg,
+				    gen_rtx_UNSPEC (Pmode,
+						    gen_rtvec (1, section_base),
+						    29)));
+	  else
+	    emit_move_insn (section_base_reg, section_base);
 	  
 	  pic_ref = gen_rtx_PLUS (Pmode, section_base_reg, orig);
 	}
@@ -1890,6 +2323,27 @@ legitimize_pic_text_address (orig, calling)
 
   return pic_ref;
 }
+
+/* Return the address from which to fetch a dispatch table entry, given
+   ADDR, which do_tablejump has made as (plus (mult INDEX 2) TABLE).  The
+   index has been checked against the table's size, so the entry's offset
+   fits in a word: double just the low half of INDEX and use it as a word
+   index, which saves zero-extending it to a long and loading the table's
+   address into a register.  */
+rtx
+palmos_case_vector_address (addr)
+     rtx addr;
+{
+  rtx index = gen_lowpart (HImode, XEXP (XEXP (addr, 0), 0));
+
+  /* CASE_VECTOR_MODE is HImode, so the scale is 2.  */
+  index = force_reg (HImode, index);
+  index = force_reg (HImode, expand_binop (HImode, add_optab, index, index,
+					   NULL_RTX, 1, OPTAB_LIB_WIDEN));
+
+  return gen_rtx_PLUS (Pmode, gen_rtx_SIGN_EXTEND (Pmode, index),
+		       XEXP (addr, 1));
+}
 #endif
 
 rtx
@@ -1188,7 +1188,10 @@ while(0)
    to allow for the place that a6 is stored when we do have a frame pointer.
    Otherwise, we would need to compute the offset from the frame pointer
    of a local variable as a function of frame_pointer_needed, which
-   is hard.  */
+   is hard.
+
+   The PIC register is not counted: output_function_prologue doesn't
+   save it.  */
 
 #define EXTRA_REGISTER_SAVE(REGNO) 0
 
@@ -1202,8 +1205,6 @@ while(0)
     if ((regs_ever_live[regno] && ! call_used_regs[regno])	\
 	|| EXTRA_REGISTER_SAVE (regno))				\
       offset += 4;						\
-  if (flag_pic && current_function_uses_pic_offset_table)	\
-    offset += 4;						\
   (DEPTH) = (offset + ((get_frame_size () + 3) & -4)		\
 	     + (get_frame_size () == 0 ? 0 : 4));		\
 }
@@ -1643,9 +1644,13 @@ __transfer_from_trampoline ()					\
    relative to an average of the time for add and the time for shift,
    taking away a little more because sometimes move insns are needed.  */
 /* div?.w is relatively cheaper on 68000 counted in COSTS_N_INSNS terms.  */
+/* With -Os, mul?.w and div?.w cost about as much as the one or two
+   instructions that they are, so that multiplying or dividing by a
+   constant isn't expanded into a longer sequence of shifts and adds.  */
 #define MULL_COST (TARGET_68060 ? 2 : TARGET_68040 ? 5 : 13)
-#define MULW_COST (TARGET_68060 ? 2 : TARGET_68040 ? 3 : TARGET_68020 ? 8 : 5)
-#define DIVW_COST (TARGET_68020 ? 27 : 12)
+#define MULW_COST (optimize_size ? 1 : TARGET_68060 ? 2 : TARGET_68040 ? 3 \
+		   : TARGET_68020 ? 8 : 5)
+#define DIVW_COST (optimize_size ? 2 : TARGET_68020 ? 27 : 12)
 
 #define RTX_COSTS(X,CODE,OUTER_CODE)				\
   case PLUS:							\
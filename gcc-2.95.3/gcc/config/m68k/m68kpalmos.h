@@ -62,6 +62,14 @@ extern int palmos_pic_reg;
       }									\
   }
 
+/* The register via which global data are accessed, A5 or (with -mown-gp)
+   A4, is preserved across calls, although A4 is call-used.  Telling the
+   loop optimizer so lets it keep the addresses of globals used in a loop
+   in registers, rather than recomputing them on each iteration.  A loop
+   that does set the register itself, as startup code and callbacks may,
+   still treats it as variant.  */
+#define INVARIANT_REGNO_P(REGNO)  ((REGNO) == PIC_OFFSET_TABLE_REGNUM)
+
 /* Make the prologue and epilogue save/restore A4 if necessary even though
    it's a call-used register.  */
 #undef EXTRA_REGISTER_SAVE
@@ -107,6 +115,19 @@ extern int palmos_pic_reg;
 #define MASK_RET_PTRS_A0	131072
 #define TARGET_RET_PTRS_A0	(target_flags & MASK_RET_PTRS_A0)
 
+#define MASK_LAZY_SECTIONS	262144
+#define TARGET_LAZY_SECTIONS	(target_flags & MASK_LAZY_SECTIONS)
+
+extern char *output_lazy_section_base ();
+
+#define MASK_FAST_FLOAT		524288
+#define TARGET_FAST_FLOAT	(target_flags & MASK_FAST_FLOAT)
+
+#define MASK_NFM_INLINE		1048576
+#define TARGET_NFM_INLINE	(target_flags & MASK_NFM_INLINE)
+
+extern void palmos_init_nfm_libfuncs ();
+
 #undef SUBTARGET_SWITCHES
 #define SUBTARGET_SWITCHES			\
    { "debug-labels", MASK_DEBUG_LABELS },	\
@@ -118,7 +139,13 @@ extern int palmos_pic_reg;
    { "extralogues", MASK_EXTRALOGUES },		\
    { "no-extralogues", -MASK_EXTRALOGUES },	\
    { "experimental-return-reg-d0", -MASK_RET_PTRS_A0 }, \
-   { "no-experimental-return-reg-d0", MASK_RET_PTRS_A0 },
+   { "no-experimental-return-reg-d0", MASK_RET_PTRS_A0 }, \
+   { "lazy-sections", MASK_LAZY_SECTIONS },	\
+   { "no-lazy-sections", -MASK_LAZY_SECTIONS },	\
+   { "fast-float", MASK_FAST_FLOAT },		\
+   { "no-fast-float", -MASK_FAST_FLOAT },	\
+   { "nfm-inline", MASK_NFM_INLINE },		\
+   { "no-nfm-inline", -MASK_NFM_INLINE },
 
 /* Target defaults are -mpcrel -mshort -m68000 -msoft-float.  */
 #undef TARGET_DEFAULT
@@ -134,9 +161,58 @@ extern int palmos_pic_reg;
     palmos_pic_reg = (TARGET_OWN_GP)? 12 : 13;			\
   }
 
-/* Always disallow function-cse for calls to callseq functions.  */
+/* Code size matters more than anything else on Palm OS.  With -Os,
+   functions do without a frame pointer, whose link and unlk cost six
+   bytes each time, and call other functions directly rather than through
+   a register: a bsr.w is only four bytes, and the register usually has
+   to be saved and restored.  */
+#define OPTIMIZATION_OPTIONS(LEVEL, SIZE)				\
+  do {									\
+    if (SIZE)								\
+      {									\
+	flag_omit_frame_pointer = 1;					\
+	flag_no_function_cse = 1;					\
+      }									\
+  } while (0)
+
+/* With -mfast-float, single precision arithmetic and comparisons call
+   libgcc's __fast_* routines, which always round to nearest and don't
+   maintain _fpCCR.  With -mnfm-inline, all the floating point library
+   calls that -lnfm would provide issue the New Float Manager traps
+   directly instead; see palmos_init_nfm_libfuncs in m68k.c.  */
+#define INIT_TARGET_OPTABS						\
+  do {									\
+    if (TARGET_FAST_FLOAT)						\
+      {									\
+	add_optab->handlers[(int) SFmode].libfunc			\
+	  = gen_rtx_SYMBOL_REF (Pmode, "__fast_addsf3");		\
+	sub_optab->handlers[(int) SFmode].libfunc			\
+	  = gen_rtx_SYMBOL_REF (Pmode, "__fast_subsf3");		\
+	smul_optab->handlers[(int) SFmode].libfunc			\
+	  = gen_rtx_SYMBOL_REF (Pmode, "__fast_mulsf3");		\
+	flodiv_optab->handlers[(int) SFmode].libfunc			\
+	  = gen_rtx_SYMBOL_REF (Pmode, "__fast_divsf3");		\
+	neg_optab->handlers[(int) SFmode].libfunc			\
+	  = gen_rtx_SYMBOL_REF (Pmode, "__fast_negsf2");		\
+	eqsf2_libfunc = gen_rtx_SYMBOL_REF (Pmode, "__fast_eqsf2");	\
+	nesf2_libfunc = gen_rtx_SYMBOL_REF (Pmode, "__fast_nesf2");	\
+	gtsf2_libfunc = gen_rtx_SYMBOL_REF (Pmode, "__fast_gtsf2");	\
+	gesf2_libfunc = gen_rtx_SYMBOL_REF (Pmode, "__fast_gesf2");	\
+	ltsf2_libfunc = gen_rtx_SYMBOL_REF (Pmode, "__fast_ltsf2");	\
+	lesf2_libfunc = gen_rtx_SYMBOL_REF (Pmode, "__fast_lesf2");	\
+      }									\
+    if (TARGET_NFM_INLINE)						\
+      palmos_init_nfm_libfuncs ();					\
+  } while (0)
+
+/* Always disallow function-cse for calls to callseq functions, and to
+   functions taking register arguments, as an address loaded into a
+   register would be that of the stack argument entry point.  */
+extern int palmos_regparm_name_p ();
 #define FORBID_FUNCTION_CSE_P(EXP)					\
-  ((GET_CODE (EXP) == SYMBOL_REF && (XSTR ((EXP), 0))[0] == '=')	\
+  ((GET_CODE (EXP) == SYMBOL_REF					\
+    && ((XSTR ((EXP), 0))[0] == '='					\
+	|| palmos_regparm_name_p (XSTR ((EXP), 0))))			\
    || GET_CODE (EXP) == UNSPEC)
 
 
@@ -173,6 +249,62 @@ define CONSTANT_AFTER_FUNCTION_P(EXP) 1
 #undef PARM_BOUNDARY
 #define PARM_BOUNDARY 16
 
+/* With -mregparm=N, static functions that take at most N arguments, each
+   of which fits in a register, are passed them in registers: pointers in
+   A0 and A1, and other arguments in D0, D1, and D2, falling back to the
+   other kind of register when one kind runs out.  Everything else,
+   including indirect calls and library calls, uses the usual convention
+   of passing all arguments on the stack.  Which functions qualify is
+   decided when they are first declared, and recorded by a `%|' prefix to
+   their assembler names; see palmos_encode_section_info in m68k.c.  */
+extern int palmos_regparm;
+extern const char *palmos_regparm_string;
+
+#undef SUBTARGET_OPTIONS
+#define SUBTARGET_OPTIONS  { "regparm=", &palmos_regparm_string },
+
+struct palmos_args
+{
+  int nregs;			/* How many registers may be used at all.  */
+  int dregs;			/* How many data registers have been used.  */
+  int aregs;			/* Likewise address registers.  */
+};
+
+#undef CUMULATIVE_ARGS
+#define CUMULATIVE_ARGS struct palmos_args
+
+#undef INIT_CUMULATIVE_ARGS
+#define INIT_CUMULATIVE_ARGS(CUM, FNTYPE, LIBNAME, INDIRECT)		\
+  ((CUM).nregs = (CUM).dregs = (CUM).aregs = 0)
+
+extern int palmos_regparm_decl_p ();
+#define INIT_CUMULATIVE_ARGS_FNDECL(CUM, FNDECL)			\
+  ((CUM).nregs = ((FNDECL) && palmos_regparm_decl_p (FNDECL))		\
+		 ? palmos_regparm : 0)
+
+extern int palmos_arg_regno ();
+#undef FUNCTION_ARG_ADVANCE
+#define FUNCTION_ARG_ADVANCE(CUM, MODE, TYPE, NAMED)			\
+  do {									\
+    int _regno = palmos_arg_regno (&(CUM), (MODE), (TYPE));		\
+    if (_regno >= 8)							\
+      (CUM).aregs++;							\
+    else if (_regno >= 0)						\
+      (CUM).dregs++;							\
+  } while (0)
+
+extern struct rtx_def *palmos_function_arg ();
+#undef FUNCTION_ARG
+#define FUNCTION_ARG(CUM, MODE, TYPE, NAMED)				\
+  palmos_function_arg (&(CUM), (MODE), (TYPE))
+
+#undef FUNCTION_ARG_PARTIAL_NREGS
+#define FUNCTION_ARG_PARTIAL_NREGS(CUM, MODE, TYPE, NAMED)  0
+
+#undef FUNCTION_ARG_REGNO_P
+#define FUNCTION_ARG_REGNO_P(N)						\
+  (palmos_regparm && ((N) <= 2 || (N) == 8 || (N) == 9))
+
 /* It is useful to be able to specify more than the usual m68k amount of
    alignment if you want to interact with ARM subroutines.  */
 #define MAX_OFILE_ALIGNMENT  32
@@ -222,7 +354,7 @@ define CONSTANT_AFTER_FUNCTION_P(EXP) 1
 #undef CPP_SUBTARGET_SPEC
 #define CPP_SUBTARGET_SPEC \
   "%{mown-gp:-D__OWNGP__} %{mextralogues:-D__EXTRALOGUES__} \
-   %{!mnoshort:-D__INT_MAX__=32767}"
+   %{mfast-float:-D__FAST_FLOAT__} %{!mnoshort:-D__INT_MAX__=32767}"
 
 #undef SUBTARGET_EXTRA_SPECS
 #define SUBTARGET_EXTRA_SPECS \
@@ -312,6 +444,7 @@ while (0)
     *.LC0	perhaps a string constant in the .text section
     =code|func	a function with a __callseq__ attribute
     @sec|func	a function in the named section
+    %|func	a function taking register arguments (-mregparm)
     @sec|*.LC0	some kind of constant in the named section
    Note that "*@sec|.LC0" is not a valid equivalent for the last case,
    because assemble_name() understands too much about names starting
@@ -322,7 +455,8 @@ while (0)
 do									\
   {									\
     char *_name = (NAME);						\
-    while (*_name == '*' || *_name == '=' || *_name == '@') {		\
+    while (*_name == '*' || *_name == '=' || *_name == '@'		\
+	   || *_name == '%') {						\
       if (*_name != '*')  while (*_name != '\036')  _name++;		\
       _name++;								\
       }									\
@@ -339,6 +473,42 @@ while (0)
   asm_fprintf (file, "%0U%s", real_name);				\
   } while (0)
 
+/* Functions taking register arguments can't be called through a pointer
+   in the usual way, so whenever their addresses are taken, in code or in
+   initialized data, use instead that of an entry point which loads the
+   arguments from the stack.  Those entry points are output at the end of
+   the file, for the functions that need them.  */
+extern struct rtx_def *palmos_stack_entry_address ();
+#undef ASM_OUTPUT_INT
+#define ASM_OUTPUT_INT(FILE,VALUE)					\
+( fprintf (FILE, "\t.long "),						\
+  output_addr_const (FILE, palmos_stack_entry_address (VALUE)),		\
+  fprintf (FILE, "\n"))
+
+extern void palmos_output_stack_entries ();
+#define ASM_FILE_END(FILE)  palmos_output_stack_entries (FILE)
+
+/* Fetch dispatch table entries with a word index, PC-relative to the
+   table, which immediately follows the jump:
+	lsl.w #1,%d0
+	move.w .L5(%pc,%d0.w),%d0
+	jmp %pc@(2,%d0:w)
+   .L5:	.word .L7-.L5 ...  */
+extern struct rtx_def *palmos_case_vector_address ();
+#undef PIC_CASE_VECTOR_ADDRESS
+#define PIC_CASE_VECTOR_ADDRESS(INDEX)  palmos_case_vector_address (INDEX)
+
+#define ASM_OUTPUT_CASE_FETCH(FILE, LABELNO, REGNAME)			\
+  asm_fprintf (FILE, "%LL%d(%Rpc,%s.", LABELNO, REGNAME)
+
+/* That makes a dispatch through a table take about as long as three
+   compare-and-branches, and smaller than the tree of them for as few as
+   four dense cases.  But each hole costs a word, so with -Os a table is
+   used only when it's denser than about one case label in four.  */
+#define CASE_VALUES_THRESHOLD  4
+#define CASE_VALUES_MAX_RANGE(COUNT)					\
+  (optimize_size ? 4 * (COUNT) - 10 : 10 * (COUNT))
+
 
 #undef LEGITIMATE_PIC_OPERAND_P
 #define LEGITIMATE_PIC_OPERAND_P(X)					\
@@ -4352,6 +4352,9 @@ assign_parms (fndecl, second_time)
 #else
   INIT_CUMULATIVE_ARGS (args_so_far, fntype, NULL_RTX, 0);
 #endif
+#ifdef INIT_CUMULATIVE_ARGS_FNDECL
+  INIT_CUMULATIVE_ARGS_FNDECL (args_so_far, fndecl);
+#endif
 
   /* We haven't yet found an argument that we must push and pretend the
      caller did.  */
@@ -549,7 +549,19 @@ UDItype __umulsidi3 (USItype, USItype);
 	     "g" ((USItype) (b))					\
 	   : "d0", "d1", "d2", "d3", "d4")
 #define UMUL_TIME 100
+#if defined (__palmos__)
+/* lb1sf68palmos.asm has this, which does each step with a divu.  */
+#define udiv_qrnnd(q, r, n1, n0, d) \
+  do { USItype __r;							\
+    (q) = __udiv_qrnnd (&__r, (n1), (n0), (d));				\
+    (r) = __r;								\
+  } while (0)
+extern USItype __udiv_qrnnd ();
+#define UDIV_NEEDS_NORMALIZATION 1
+#define UDIV_TIME 250
+#else
 #define UDIV_TIME 400
+#endif
 #endif /* not mcf5200 */
 #endif /* not mc68020 */
 
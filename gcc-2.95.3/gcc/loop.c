@@ -764,6 +764,12 @@ scan_loop (loop_start, end, loop_cont, unroll_p, bct_p)
   for (i = 0; i < FIRST_PSEUDO_REGISTER; i++)
     {
       VARRAY_CHAR (may_not_optimize, i) = 1;
+#ifdef INVARIANT_REGNO_P
+      /* Keep the real count for a register that calls preserve, so that
+	 it is invariant in loops that do not set it themselves.  */
+      if (INVARIANT_REGNO_P (i))
+	continue;
+#endif
       VARRAY_INT (set_in_loop, i) = 1;
     }
 
@@ -3256,8 +3262,15 @@ invariant_p (x)
 	  && ! current_function_has_nonlocal_goto)
 	return 1;
 
+      /* Some targets have a register, such as one used to address global
+	 data, that calls preserve even though it is call-used.  It is still
+	 variant if the loop itself sets it.  */
       if (loop_has_call
-	  && REGNO (x) < FIRST_PSEUDO_REGISTER && call_used_regs[REGNO (x)])
+	  && REGNO (x) < FIRST_PSEUDO_REGISTER && call_used_regs[REGNO (x)]
+#ifdef INVARIANT_REGNO_P
+	  && ! INVARIANT_REGNO_P (REGNO (x))
+#endif
+	  )
 	return 0;
 
       if (VARRAY_INT (set_in_loop, REGNO (x)) < 0)
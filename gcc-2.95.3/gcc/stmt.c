@@ -5129,10 +5129,16 @@ expand_end_case (orig_index)
 #endif /* HAVE_casesi */
 #endif /* CASE_VALUES_THRESHOLD */
 
+      /* The greatest range of values for which a dispatch table is
+	 used, given COUNT case labels.  */
+#ifndef CASE_VALUES_MAX_RANGE
+#define CASE_VALUES_MAX_RANGE(COUNT) (10 * (COUNT))
+#endif
+
       else if (TREE_INT_CST_HIGH (range) != 0
 	       || count < (unsigned int) CASE_VALUES_THRESHOLD
 	       || ((unsigned HOST_WIDE_INT) (TREE_INT_CST_LOW (range))
-		   > 10 * count)
+		   > (unsigned HOST_WIDE_INT) CASE_VALUES_MAX_RANGE (count))
 #ifndef ASM_OUTPUT_ADDR_DIFF_ELT
 	       || flag_pic
 #endif
@@ -219,6 +219,7 @@ static void close_dump_file PROTO((void (*) (FILE *, rtx), rtx));
 static void dump_rtl PROTO((const char *, tree, void (*) (FILE *, rtx), rtx));
 static void clean_dump_file PROTO((const char *));
 static void compile_file PROTO((char *));
+static int symbol_referenced_p PROTO((tree));
 static void display_help PROTO ((void));
 
 static void print_version PROTO((FILE *, const char *));
@@ -2695,6 +2696,29 @@ clean_dump_file (suffix)
   return;
 }
 
+/* Return nonzero if the symbol of DECL, a function, has been referenced.
+   assemble_name records this under the name it outputs, which for a
+   function given its name by an asm declaration is not the
+   DECL_ASSEMBLER_NAME.  */
+static int
+symbol_referenced_p (decl)
+     tree decl;
+{
+  rtx x = DECL_RTL (decl);
+  char *real_name;
+  tree id;
+
+  if (TREE_SYMBOL_REFERENCED (DECL_ASSEMBLER_NAME (decl)))
+    return 1;
+
+  if (x == 0 || GET_CODE (x) != MEM || GET_CODE (XEXP (x, 0)) != SYMBOL_REF)
+    return 0;
+
+  STRIP_NAME_ENCODING (real_name, XSTR (XEXP (x, 0), 0));
+  id = maybe_get_identifier (real_name);
+  return id != NULL_TREE && TREE_SYMBOL_REFERENCED (id);
+}
+
 /* Do any final processing required for the declarations in VEC, of
    which there are LEN.  We write out inline functions and variables
    that have been deferred until this point, but which are required.
@@ -2774,7 +2798,7 @@ wrapup_global_declarations (vec, len)
 	      && DECL_SAVED_INSNS (decl) != 0
 	      && (flag_keep_inline_functions
 		  || (TREE_PUBLIC (decl) && !DECL_COMDAT (decl))
-		  || TREE_SYMBOL_REFERENCED (DECL_ASSEMBLER_NAME (decl))))
+		  || symbol_referenced_p (decl)))
 	    {
 	      reconsider = 1;
 	      temporary_allocation ();
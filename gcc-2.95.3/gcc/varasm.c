@@ -651,6 +651,10 @@ make_decl_rtl (decl, asmspec, top_level)
 				     strlen (asmspec) + 2);
       name[0] = '*';
       strcpy (&name[1], asmspec);
+
+      /* Create the identifier under which assemble_name records that the
+	 name has been used, as toplev.c checks that for deferred functions.  */
+      get_identifier (asmspec);
     }
 
   /* For a duplicate declaration, we can be called twice on the
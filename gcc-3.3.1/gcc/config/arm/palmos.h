@@ -22,7 +22,16 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
    We could do the latter with SUBTARGET_CONDITIONAL_REGISTER_USAGE instead,
    but this is more visible for our paranoid users.  */
 #undef CC1_SPEC
-#define CC1_SPEC  "-fPIC -ffixed-r9"
+#define CC1_SPEC  "-fPIC -ffixed-r9 %{mthumb:-mthumb-interwork}"
+
+/* Palm OS always enters an armlet in ARM state, so Thumb code must at least
+   be able to return to ARM code.  Hence -mthumb implies -mthumb-interwork,
+   both for the compiler, above, and for the assembler, so that the linker
+   knows that ARM callers can be given a veneer to Thumb code.  Thumb code
+   uses %sl as its PIC register, just as ARM code does, and so also leaves
+   %r9 alone.  */
+#undef SUBTARGET_EXTRA_ASM_SPEC
+#define SUBTARGET_EXTRA_ASM_SPEC  "%{mthumb:-mthumb-interwork}"
 
 #define SUBTARGET_CPU_DEFAULT  TARGET_CPU_arm7tdmi
 
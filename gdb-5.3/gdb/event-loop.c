@@ -722,8 +722,8 @@ handle_file_event (int event_file_desc)
    detected by the poll. 
    If there are no events, this function will block in the 
    call to poll.
-   Return -1 if there are no files descriptors to monitor, 
-   otherwise return 0. */
+   Return -1 if there are no files descriptors to monitor and no
+   timers pending, otherwise return 0. */
 static int
 gdb_wait_for_event (void)
 {
@@ -736,7 +736,7 @@ gdb_wait_for_event (void)
   gdb_flush (gdb_stdout);
   gdb_flush (gdb_stderr);
 
-  if (gdb_notifier.num_fds == 0)
+  if (gdb_notifier.num_fds == 0 && !gdb_notifier.timeout_valid)
     return -1;
 
   if (use_poll)
@@ -0,0 +1,99 @@
+/* Cache of MacsBug routine names for the Palm OS remote target.
+   Copyright 2003 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA 02111-1307, USA.  */
+
+/* palmos-namestst.c includes this file directly, having defined
+   PALMOS_NAMES_TEST and provided what defs.h otherwise would.  */
+#ifndef PALMOS_NAMES_TEST
+#include "defs.h"
+#include "gdb_string.h"
+#endif
+
+#include "palmos-names.h"
+
+struct macsbug_name *macsbug_names = NULL;
+int num_macsbug_names = 0;
+static int max_macsbug_names = 0;
+
+/* Forget all the names.  */
+
+void
+free_macsbug_names (void)
+{
+  int i;
+
+  for (i = 0; i < num_macsbug_names; i++)
+    xfree (macsbug_names[i].name);
+  num_macsbug_names = 0;
+}
+
+/* Return the index of the entry containing PC, or -1.  */
+
+int
+find_macsbug_name (CORE_ADDR pc)
+{
+  int lo = 0, hi = num_macsbug_names;
+
+  /* Find the last entry starting at or before PC.  */
+  while (lo < hi)
+    {
+      int mid = (lo + hi) / 2;
+      if (macsbug_names[mid].start <= pc)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  if (lo > 0 && pc < macsbug_names[lo - 1].end)
+    return lo - 1;
+  else
+    return -1;
+}
+
+/* Record that [START, END) is called NAME, replacing any entries it
+   overlaps.  Returns the cached copy of NAME.  */
+
+char *
+add_macsbug_name (CORE_ADDR start, CORE_ADDR end, const char *name)
+{
+  int lo, hi, num;
+
+  /* Entries [lo, hi) overlap the new one, which takes their place.  */
+  for (lo = 0; lo < num_macsbug_names && macsbug_names[lo].end <= start; lo++)
+    ;
+  for (hi = lo; hi < num_macsbug_names && macsbug_names[hi].start < end; hi++)
+    xfree (macsbug_names[hi].name);
+
+  num = num_macsbug_names - (hi - lo) + 1;
+  if (num > max_macsbug_names)
+    {
+      max_macsbug_names = max_macsbug_names ? 2 * max_macsbug_names : 256;
+      macsbug_names = xrealloc (macsbug_names, max_macsbug_names
+				* sizeof (struct macsbug_name));
+    }
+
+  memmove (&macsbug_names[lo + 1], &macsbug_names[hi],
+	   (num_macsbug_names - hi) * sizeof (struct macsbug_name));
+  num_macsbug_names = num;
+
+  macsbug_names[lo].start = start;
+  macsbug_names[lo].end = end;
+  macsbug_names[lo].name = name ? xstrdup (name) : NULL;
+  return macsbug_names[lo].name;
+}
@@ -0,0 +1,38 @@
+/* Cache of MacsBug routine names for the Palm OS remote target.
+   Copyright 2003 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA 02111-1307, USA.  */
+
+#ifndef PALMOS_NAMES_H
+#define PALMOS_NAMES_H
+
+struct macsbug_name
+{
+  CORE_ADDR start, end;		/* The routine occupies [start, end).  */
+  char *name;			/* NULL if it has no name.  */
+};
+
+/* The cached names, sorted by address and not overlapping.  */
+extern struct macsbug_name *macsbug_names;
+extern int num_macsbug_names;
+
+void free_macsbug_names (void);
+int find_macsbug_name (CORE_ADDR pc);
+char *add_macsbug_name (CORE_ADDR start, CORE_ADDR end, const char *name);
+
+#endif /* PALMOS_NAMES_H */
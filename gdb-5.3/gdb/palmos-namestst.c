@@ -0,0 +1,151 @@
+/* Host-side tests for the MacsBug name cache in palmos-names.c.
+
+   This is built with the host's compiler, without the rest of GDB (see
+   the check-palmos-names target in Makefile.in).  It adds names at the
+   front, middle and end of the table and over existing entries, and
+   checks the table after each step.
+
+   This code is in the public domain.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef unsigned long CORE_ADDR;
+
+static int allocated = 0;
+
+static void *
+xrealloc (void *p, size_t size)
+{
+  p = realloc (p, size);
+  if (p == NULL)
+    abort ();
+  return p;
+}
+
+static char *
+xstrdup (const char *s)
+{
+  allocated++;
+  return strcpy (xrealloc (NULL, strlen (s) + 1), s);
+}
+
+static void
+xfree (void *p)
+{
+  if (p != NULL)
+    allocated--;
+  free (p);
+}
+
+#define PALMOS_NAMES_TEST
+#include "palmos-names.c"
+
+static int failures = 0;
+
+/* Check that the table holds exactly the entries described by EXPECT,
+   a string of "start-end:name" items separated by spaces, with "-" for a
+   NULL name.  */
+
+static void
+check (const char *what, const char *expect)
+{
+  char got[1000], *p = got;
+  int i, names = 0;
+
+  got[0] = '\0';
+  for (i = 0; i < num_macsbug_names; i++)
+    {
+      struct macsbug_name *n = &macsbug_names[i];
+      p += sprintf (p, "%s%lx-%lx:%s", (i > 0)? " " : "",
+		    n->start, n->end, (n->name)? n->name : "-");
+      if (n->name)
+	names++;
+    }
+
+  if (strcmp (got, expect) != 0 || names != allocated)
+    {
+      printf ("%s: got \"%s\" (%d names allocated), expected \"%s\"\n",
+	      what, got, allocated, expect);
+      failures++;
+    }
+}
+
+static void
+check_find (CORE_ADDR pc, const char *expect)
+{
+  int i = find_macsbug_name (pc);
+  const char *got = (i < 0)? "none"
+		    : (macsbug_names[i].name)? macsbug_names[i].name : "-";
+
+  if (strcmp (got, expect) != 0)
+    {
+      printf ("find %lx: got %s, expected %s\n", pc, got, expect);
+      failures++;
+    }
+}
+
+int
+main ()
+{
+  char *name;
+  int i;
+
+  add_macsbug_name (0x200, 0x280, "middle");
+  check ("first", "200-280:middle");
+  add_macsbug_name (0x100, 0x180, "front");
+  check ("front", "100-180:front 200-280:middle");
+  add_macsbug_name (0x400, 0x480, "end");
+  check ("end", "100-180:front 200-280:middle 400-480:end");
+  add_macsbug_name (0x300, 0x301, NULL);
+  check ("between",
+	 "100-180:front 200-280:middle 300-301:- 400-480:end");
+  add_macsbug_name (0x180, 0x200, "touching");
+  check ("touching",
+	 "100-180:front 180-200:touching 200-280:middle 300-301:- 400-480:end");
+
+  name = add_macsbug_name (0x300, 0x340, "replace");
+  check ("replace one",
+	 "100-180:front 180-200:touching 200-280:middle 300-340:replace "
+	 "400-480:end");
+  if (strcmp (name, "replace") != 0)
+    {
+      printf ("replace one: returned %s\n", name);
+      failures++;
+    }
+
+  add_macsbug_name (0x150, 0x250, "spanning");
+  check ("replace three",
+	 "150-250:spanning 300-340:replace 400-480:end");
+  add_macsbug_name (0x50, 0x1000, "all");
+  check ("replace all", "50-1000:all");
+
+  check_find (0x4f, "none");
+  check_find (0x50, "all");
+  check_find (0xfff, "all");
+  check_find (0x1000, "none");
+
+  /* Enough to make the table grow.  */
+  free_macsbug_names ();
+  for (i = 999; i >= 0; i--)
+    {
+      char buf[20];
+
+      sprintf (buf, "r%d", i);
+      add_macsbug_name (0x10000 + i * 16, 0x10000 + i * 16 + 8, buf);
+    }
+  if (num_macsbug_names != 1000 || allocated != 1000)
+    {
+      printf ("grow: %d entries, %d names\n", num_macsbug_names, allocated);
+      failures++;
+    }
+  check_find (0x10000 + 500 * 16 + 4, "r500");
+  check_find (0x10000 + 500 * 16 + 8, "none");
+
+  free_macsbug_names ();
+  check ("free", "");
+
+  printf ("%d failures\n", failures);
+  return failures != 0;
+}
@@ -39,6 +39,12 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.  */
 #include "objfiles.h"
 #include "gdb-stabs.h"
 #include "gdbthread.h"
+#include "gdb_stat.h"
+#include <ctype.h>
+#include <time.h>
+#include "event-loop.h"
+#include "event-top.h"
+#include "inf-loop.h"
 
 #ifdef USG
 #include <sys/types.h>
@@ -47,6 +53,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.  */
 #include <signal.h>
 #include "serial.h"
 #include "xmodem.h"
+#include "palmos-names.h"
 
 /* Prototypes for local functions */
 
@@ -126,9 +133,33 @@ static void remote_insert_wbreakpoint PARAMS ((CORE_ADDR addr,
 
 static enum target_signal remote_remove_wbreakpoint PARAMS ((void));
 
+static void clear_macsbug_names PARAMS ((void));
+
+static void remote_async_open PARAMS ((char *name, int from_tty));
+
+static void remote_async_resume PARAMS ((ptid_t ptid, int step,
+					 enum target_signal siggnal));
+
+static void remote_async_mourn PARAMS ((void));
+
+static void palmos_log_message PARAMS ((char *text));
+
+static void palmos_log_flush PARAMS ((void));
+
+static void handle_remote_sigint PARAMS ((int sig));
+
+static int remote_input_pending PARAMS ((void));
+
 extern struct target_ops palmos_ops, pilot_ops;	/* Forward decl */
+extern struct target_ops palmos_async_ops;
 
 static CORE_ADDR text_addr=0, data_addr=0, bss_addr=0;
+
+/* Where the target's crt0 locked each code resource, as reported by the
+   extended startup handshake.  code_addrs[0] is code #1, which TEXT_ADDR
+   already covers; code_addrs[N] is code #N+1.  */
+static CORE_ADDR *code_addrs = NULL;
+static int num_code_addrs = 0;
 static CORE_ADDR save_ssp, save_usp;
 static enum target_signal wbreakpoint_signo;
 static CORE_ADDR wbreakpoint_addr;
@@ -228,11 +259,51 @@ docrc (p, len)
   return crc;
 }
 
-  
+
+/* Return which code resource (counting code #1 as 0) holds SECT.
+   multigen emits a __text__SECT base pointer for each extra section,
+   laid out in code resource order after __text__, so the distance
+   between them gives the index.  Failing that, assume the code
+   sections appear in the object file in code resource order; *NEXTP
+   counts them.  */
+
+static int
+code_resource_index (objfile, sect, nextp)
+     struct objfile *objfile;
+     asection *sect;
+     int *nextp;
+{
+  struct minimal_symbol *table, *base;
+  char *name;
+
+  name = alloca (strlen ("__text__") + strlen (sect->name) + 1);
+  strcpy (name, "__text__");
+  strcat (name, sect->name);
+
+  table = lookup_minimal_symbol ("__text__", NULL, objfile);
+  base = lookup_minimal_symbol (name, NULL, objfile);
+  if (table != NULL && base != NULL
+      && SYMBOL_SECTION (table) == SYMBOL_SECTION (base))
+    {
+      /* Both are in the same section, so relocation doesn't matter.  */
+      return (SYMBOL_VALUE_ADDRESS (base) - SYMBOL_VALUE_ADDRESS (table)) / 4;
+    }
+
+  return ++*nextp;
+}
+
+/* Relocate the symbol file to where the target has put it.  Text, data
+   and bss each get their own offset, and so does each extra code
+   section of a multiple code resource program, all in a single
+   objfile_relocate.  */
+
 static void
 get_offsets ()
 {
   struct section_offsets *offs;
+  bfd *abfd;
+  asection *sect;
+  int next_code;
   
   if (symfile_objfile == NULL)
     return;
@@ -240,6 +311,8 @@ get_offsets ()
   if ((text_addr == 0) && (data_addr==0) && (bss_addr==0))
     return;
 
+  abfd = symfile_objfile->obfd;
+
   offs = (struct section_offsets *) alloca (sizeof (struct section_offsets)
 					    + symfile_objfile->num_sections
 					    * sizeof (offs->offsets));
@@ -249,13 +322,31 @@ get_offsets ()
 	  * sizeof (offs->offsets));
 
   offs->offsets[SECT_OFF_TEXT (symfile_objfile)] = text_addr;
-
-  /* This is a temporary kludge to force data and bss to use the same offsets
-     because that's what nlmconv does now.  The real solution requires changes
-     to the stub and remote.c that I don't have time to do right now.  */
-
   offs->offsets[SECT_OFF_DATA (symfile_objfile)] = data_addr;
-  offs->offsets[SECT_OFF_BSS  (symfile_objfile)] = data_addr;
+
+  /* The target reports the address of bss_start, which the linker script
+     puts at the start of .bss.  */
+  sect = bfd_get_section_by_name (abfd, ".bss");
+  if (sect != NULL && bss_addr != 0)
+    offs->offsets[SECT_OFF_BSS (symfile_objfile)]
+      = bss_addr - bfd_section_vma (abfd, sect);
+  else
+    offs->offsets[SECT_OFF_BSS (symfile_objfile)] = data_addr;
+
+  next_code = 0;
+  for (sect = abfd->sections; sect != NULL; sect = sect->next)
+    if ((bfd_get_section_flags (abfd, sect) & SEC_CODE)
+	&& sect->index != SECT_OFF_TEXT (symfile_objfile)
+	&& sect->index < symfile_objfile->num_sections)
+      {
+	int n = code_resource_index (symfile_objfile, sect, &next_code);
+
+	/* A zero base means that resource has not been locked yet, as
+	   happens with -mlazy-sections; leave its section unrelocated.  */
+	if (n > 0 && n < num_code_addrs && code_addrs[n] != 0)
+	  offs->offsets[sect->index]
+	    = code_addrs[n] - bfd_section_vma (abfd, sect);
+      }
 
   objfile_relocate (symfile_objfile, offs);
 }
@@ -301,6 +392,18 @@ remote_open_pilot (name, from_tty)
   remote_open_1 (name, from_tty, &pilot_ops);
 }
 
+/* With this target we start out by owning the terminal.  */
+static int remote_async_terminal_ours_p;
+
+static void
+remote_async_open (name, from_tty)
+     char *name;
+     int from_tty;
+{
+  remote_async_terminal_ours_p = 1;
+  remote_open_1 (name, from_tty, &palmos_async_ops);
+}
+
 /* Generic code for opening a connection to a remote target.  */
 
 static struct serial *remote_desc = NULL;
@@ -338,6 +441,7 @@ remote_open_1 (name, from_tty, target)
   serial_raw (remote_desc);
   
   crcinit();
+  clear_macsbug_names ();
   
   if (from_tty)
     {
@@ -484,6 +588,194 @@ Give up (and stop debugging it)? "))
   target_terminal_inferior ();
 }
 
+/* The asynchronous target, palmos-async, is like palmos except that while
+   the application runs, gdb stays in its event loop: the serial line is
+   registered with it, so that debug messages are dealt with as they come
+   in and ^C is handled asynchronously.  The SIGINT handling follows the
+   async target in remote.c.  */
+
+static void *sigint_remote_token;
+static void *sigint_remote_twice_token;
+
+/* Ask the target to stop, by sending it a state query.  */
+
+static void
+remote_stop ()
+{
+  char buffer[2];
+
+  buffer[0] = 0;
+  buffer[1] = 0;
+  putpkt(buffer, 2);
+}
+
+static void
+async_remote_interrupt (arg)
+     gdb_client_data arg;
+{
+  target_stop ();
+}
+
+static void
+async_remote_interrupt_twice (arg)
+     gdb_client_data arg;
+{
+  /* Do something only if the target was not killed by the previous ^C.  */
+  if (target_executing)
+    {
+      interrupt_query ();
+      signal (SIGINT, handle_remote_sigint);
+    }
+}
+
+static void
+handle_remote_sigint_twice (sig)
+     int sig;
+{
+  signal (sig, handle_sigint);
+  sigint_remote_twice_token =
+    create_async_signal_handler (inferior_event_handler_wrapper, NULL);
+  mark_async_signal_handler_wrapper (sigint_remote_twice_token);
+}
+
+static void
+handle_remote_sigint (sig)
+     int sig;
+{
+  signal (sig, handle_remote_sigint_twice);
+  sigint_remote_twice_token =
+    create_async_signal_handler (async_remote_interrupt_twice, NULL);
+  mark_async_signal_handler_wrapper (sigint_remote_token);
+}
+
+static void
+initialize_sigint_signal_handler ()
+{
+  sigint_remote_token =
+    create_async_signal_handler (async_remote_interrupt, NULL);
+  signal (SIGINT, handle_remote_sigint);
+}
+
+static void
+cleanup_sigint_signal_handler (dummy)
+     void *dummy;
+{
+  signal (SIGINT, handle_sigint);
+  if (sigint_remote_twice_token)
+    delete_async_signal_handler ((struct async_signal_handler **)
+				 &sigint_remote_twice_token);
+  if (sigint_remote_token)
+    delete_async_signal_handler ((struct async_signal_handler **)
+				 &sigint_remote_token);
+}
+
+static void
+remote_async_terminal_inferior ()
+{
+  if (!sync_execution || !remote_async_terminal_ours_p)
+    return;
+  delete_file_handler (input_fd);
+  remote_async_terminal_ours_p = 0;
+  initialize_sigint_signal_handler ();
+}
+
+static void
+remote_async_terminal_ours ()
+{
+  if (!sync_execution || remote_async_terminal_ours_p)
+    return;
+  cleanup_sigint_signal_handler (NULL);
+  add_file_handler (input_fd, stdin_event_handler, 0);
+  remote_async_terminal_ours_p = 1;
+}
+
+static void
+remote_async_resume (ptid, step, siggnal)
+     ptid_t ptid;
+     int step;
+     enum target_signal siggnal;
+{
+  remote_resume (ptid, step, siggnal);
+
+  /* We are about to start executing the inferior, so register it with
+     the event loop.  */
+  if (event_loop_p && target_can_async_p ())
+    target_async (inferior_event_handler, 0);
+  if (target_is_async_p ())
+    target_executing = 1;
+}
+
+static void
+remote_async_kill ()
+{
+  /* Unregister the file descriptor from the event loop.  */
+  if (target_is_async_p ())
+    serial_async (remote_desc, NULL, 0);
+
+  remote_kill ();
+}
+
+static void
+remote_async_detach (args, from_tty)
+     char *args;
+     int from_tty;
+{
+  if (target_is_async_p ())
+    serial_async (remote_desc, NULL, 0);
+
+  remote_detach (args, from_tty);
+}
+
+static int
+remote_can_async_p ()
+{
+  return current_target.to_async_mask_value
+	 && serial_can_async_p (remote_desc);
+}
+
+static int
+remote_is_async_p ()
+{
+  return current_target.to_async_mask_value
+	 && serial_is_async_p (remote_desc);
+}
+
+static void (*async_client_callback) (enum inferior_event_type event_type,
+				      void *context);
+static void *async_client_context;
+
+static void
+remote_async_serial_handler (struct serial *scb, void *context)
+{
+  /* Don't propagate error information up to the client.  Instead let
+     the client find out about the error by querying the target.  */
+  async_client_callback (INF_REG_EVENT, async_client_context);
+}
+
+static void
+remote_async (void (*callback) (enum inferior_event_type event_type,
+				void *context),
+	      void *context)
+{
+  if (current_target.to_async_mask_value == 0)
+    internal_error (__FILE__, __LINE__,
+		    "Calling remote_async when async is masked");
+
+  if (callback != NULL)
+    {
+      serial_async (remote_desc, remote_async_serial_handler, NULL);
+      async_client_callback = callback;
+      async_client_context = context;
+
+      /* The serial layer only schedules its handler when it is next read
+	 from, so poll it now; anything already waiting will be delivered
+	 from the event loop.  */
+      remote_input_pending ();
+    }
+  else
+    serial_async (remote_desc, NULL, NULL);
+}
+
 static long computeSignal( long exceptionVector )
 {
   long sigval;
@@ -529,6 +821,9 @@ static long computeSignal( long exceptionVector )
 /* If nonzero, ignore the next kill.  */
 int kill_kludge;
 
+/* A character read by remote_input_pending, or -1.  */
+static int pending_char = -1;
+
 /* Read a single character from the remote end. */
 
 static int
@@ -537,6 +832,13 @@ readchar (timeout)
      {
        int ch;
        
+       if (pending_char >= 0)
+	 {
+	   ch = pending_char;
+	   pending_char = -1;
+	   return ch;
+	 }
+
        ch = serial_readchar (remote_desc, timeout);
          
        switch (ch)
@@ -552,6 +854,178 @@ readchar (timeout)
       }
 }
 
+/* Return non-zero if there's more input from the target waiting to be
+   read, without blocking.  */
+
+static int
+remote_input_pending ()
+{
+  if (pending_char < 0)
+    {
+      int ch = serial_readchar (remote_desc, 0);
+
+      if (ch < 0)
+	return 0;
+      pending_char = ch;
+    }
+
+  return 1;
+}
+
+/* Message packets carry the application's debug console output, and an
+   application that logs heavily can send a great many of them.  Rather
+   than writing each one to the terminal as it arrives, they're collected
+   here and written out whenever the target has nothing more to send for
+   the moment.  At most palmos_log_rate lines a second are shown; the rest
+   are counted and summarised.  Everything also goes to palmos_log_file,
+   if that is set.  */
+
+static char *palmos_log_file = NULL;
+static int palmos_log_rate = 0;
+
+static char *log_buffer = NULL;
+static int log_length = 0, log_size = 0;
+
+static FILE *log_stream = NULL;
+static char *log_stream_name = NULL;
+
+static time_t log_second;
+static int log_lines_this_second;
+static long log_lines_suppressed;
+
+/* Flush the console output before it grows larger than this.  */
+#define LOG_FLUSH_SIZE 4096
+
+static void
+log_append (text, len)
+     const char *text;
+     int len;
+{
+  if (log_length + len + 1 > log_size)
+    {
+      log_size = (log_length + len + 1) * 2;
+      log_buffer = xrealloc (log_buffer, log_size);
+    }
+  memcpy (log_buffer + log_length, text, len);
+  log_length += len;
+  log_buffer[log_length] = '\0';
+}
+
+/* Add a note about any lines that were dropped to the console output.  */
+
+static void
+log_note_suppressed ()
+{
+  char note[80];
+
+  if (log_lines_suppressed == 0)
+    return;
+
+  sprintf (note, "[%ld line%s of target output suppressed]\n",
+	   log_lines_suppressed, (log_lines_suppressed == 1)? "" : "s");
+  log_append (note, strlen (note));
+  log_lines_suppressed = 0;
+}
+
+/* Make sure LOG_STREAM is open on palmos_log_file, if it's set.  */
+
+static void
+log_open_file ()
+{
+  const char *name = (palmos_log_file && palmos_log_file[0])
+		     ? palmos_log_file : NULL;
+
+  if (log_stream_name != NULL && name != NULL
+      && strcmp (log_stream_name, name) == 0)
+    return;
+
+  if (log_stream != NULL)
+    fclose (log_stream);
+  log_stream = NULL;
+  xfree (log_stream_name);
+  log_stream_name = NULL;
+
+  if (name == NULL)
+    return;
+
+  log_stream_name = xstrdup (name);
+  log_stream = fopen (name, "a");
+  if (log_stream == NULL)
+    warning ("Can't open %s for target output: %s", name,
+	     safe_strerror (errno));
+}
+
+/* Deal with the text of one message packet.  */
+
+static void
+palmos_log_message (text)
+     char *text;
+{
+  time_t now = time (NULL);
+  char *p;
+
+  for (p = text; *p; p++)
+    if (*p == '\r')
+      *p = '\n';
+
+  log_open_file ();
+  if (log_stream != NULL)
+    fputs (text, log_stream);
+
+  if (now != log_second)
+    {
+      log_second = now;
+      log_lines_this_second = 0;
+      log_note_suppressed ();
+    }
+
+  while (*text)
+    {
+      char *eol = strchr (text, '\n');
+      int len = eol ? eol - text + 1 : strlen (text);
+
+      if (palmos_log_rate > 0 && log_lines_this_second >= palmos_log_rate)
+	{
+	  if (eol)
+	    log_lines_suppressed++;
+	}
+      else
+	{
+	  log_append (text, len);
+	  if (eol)
+	    log_lines_this_second++;
+	}
+
+      text += len;
+    }
+
+  if (log_length > LOG_FLUSH_SIZE)
+    palmos_log_flush ();
+}
+
+/* Write out the collected console output.  */
+
+static void
+palmos_log_flush ()
+{
+  if (log_stream != NULL)
+    fflush (log_stream);
+
+  if (log_length == 0)
+    return;
+
+  fputs_unfiltered (log_buffer, gdb_stdout);
+  gdb_flush (gdb_stdout);
+  log_length = 0;
+}
+
+static void
+restore_sigint (dummy)
+     void *dummy;
+{
+  signal (SIGINT, ofunc);
+}
+
 /* Wait until the remote machine stops, then return,
    storing status in STATUS just as `wait' would.
    Returns "pid" (though it's not clear what, if anything, that
@@ -566,6 +1040,7 @@ remote_wait (ptid, status)
   int len;
   int thread_num = -1;
   unsigned long ins;
+  struct cleanup *old_chain;
   
   if (startup) {
     fputs_filtered ("Waiting... (Press Ctrl-C to connect to halted machine)\n", gdb_stdout);
@@ -574,11 +1049,17 @@ remote_wait (ptid, status)
   	
   status->kind = TARGET_WAITKIND_EXITED;
     status->value.integer = 0;
+
+  /* The asynchronous target has its own SIGINT handling.  */
+  old_chain = make_cleanup (null_cleanup, NULL);
+  if (!target_is_async_p ())
+    {
+      ofunc = (void (*)()) signal (SIGINT, remote_interrupt);
+      make_cleanup (restore_sigint, NULL);
+    }
 	    
 	while (1) {
-	   ofunc = (void (*)()) signal (SIGINT, remote_interrupt);
   	   len = getpkt(&buf, 1);
-  	   signal (SIGINT, ofunc);
   	   
   	   if (len<10) /* Reception failed, skip */
   	     continue;
@@ -588,25 +1069,39 @@ remote_wait (ptid, status)
   	     continue;
   	   
 	  if (buf[10] == (char)0x7F) { /* Message */
-	      int i;
-	      for (i=12;i<len;i++) {
-	        if (buf[i] == '\r')
-	          buf[i] = '\n';
-	      }
 	      buf[len] = 0;
-	      fputs_filtered (buf+12, gdb_stdout);
+	      palmos_log_message (buf+12);
+
+	      /* Deal with everything that has already arrived before
+	         writing any of it out.  */
+	      if (remote_input_pending ())
+		continue;
+	      palmos_log_flush ();
+
+	      if (target_is_async_p ()) {
+		/* Return to the event loop, which will call us again when
+		   there's more to read.  */
+		status->kind = TARGET_WAITKIND_IGNORE;
+		break;
+	      }
 	      continue;
 	  }
 	  else if (buf[10] == (char)0x80) { /* Break & state */
 	    unsigned long sr;
 
+	    log_note_suppressed ();
+	    palmos_log_flush ();
+
 #define State_resetted 12
 #define State_exception 14
 #define State_D0 16
 #define State_D1 20
 #define State_D2 24
 #define State_D3 28
+#define State_D4 32
+#define State_D5 36
 #define State_A0 48
+#define State_A1 52
 #define State_USP 76
 #define State_SSP 80
 #define State_PC 84
@@ -671,10 +1166,32 @@ remote_wait (ptid, status)
 	      text_addr = get_long(buf+State_D0);
 	      bss_addr =  get_long(buf+State_D1);
 	      data_addr = get_long(buf+State_D2);
+	      bp = get_long(buf+State_A0);
+
+	      /* Newer crt0s also pass a table of code resource base
+	         addresses in A1, with its length in D5.  Reading it reuses
+	         BUF, so everything else must be extracted first.  */
+	      num_code_addrs = 0;
+	      if (get_long(buf+State_D4) == 0x12BEEF35) {
+		CORE_ADDR table = get_long(buf+State_A1);
+		int n = get_long(buf+State_D5);
+		int i;
+
+		if (n > 0 && n <= 255) {
+		  unsigned char *raw = alloca (n * 4);
+
+		  if (remote_read_bytes (table, (char *) raw, n * 4) == n * 4) {
+		    code_addrs = xrealloc (code_addrs, n * sizeof (CORE_ADDR));
+		    for (i = 0; i < n; i++)
+		      code_addrs[i] = get_long(raw + i * 4);
+		    num_code_addrs = n;
+		  }
+		}
+	      }
+
 	      get_offsets();
 	      /* Find pc value corresponding to first executable statement
 	         after the PilotMain prologue and insert breakpoint there.  */
-	      bp = get_long(buf+State_A0);
 	      INIT_SAL (&sal);
 	      sal = find_pc_line (bp, 0);
 	      if (sal.pc && bp != sal.pc && bp > sal.pc && bp <= sal.end)
@@ -689,6 +1206,7 @@ remote_wait (ptid, status)
 	  }
   	  puts_filtered ("Unknown packet received.\n");
 	}
+	do_cleanups (old_chain);
 	return inferior_ptid;
 }
 
@@ -815,8 +1333,13 @@ remote_write_bytes (memaddr, myaddr, len)
 	return done;
 }
 
+/* Ask the target for the MacsBug name of the routine containing MEMADDR.
+   Returns the name, or NULL if there isn't one; if START and END are
+   non-NULL they receive the bounds of the routine as the target sees
+   them.  */
+
 static char *
-remote_get_macsbug_name (CORE_ADDR memaddr)
+remote_get_macsbug_name (CORE_ADDR memaddr, CORE_ADDR *start, CORE_ADDR *end)
 {
   static const char sysPktGetRtnNameCmd = '\x04';
   static const char sysPktGetRtnNameRsp = '\x84';
@@ -834,16 +1357,312 @@ remote_get_macsbug_name (CORE_ADDR memaddr)
   if (pkt[10] == sysPktGetRtnNameRsp)
     {
       char *name = &pkt[24];
+      if (start)
+	*start = get_long (pkt+16);
+      if (end)
+	*end = get_long (pkt+20);
       return (name[0] == '\0')? NULL : name;
     }
   else
     return "funky packet";
 }
 
+/* MacsBug names are looked up on the target, which costs a round trip per
+   frame whenever a backtrace passes through the OS.  Routines in ROM
+   don't move, so we remember the name of each ROM routine along with its
+   bounds, and keep them in a file named after the ROM so that later
+   sessions start with them too.  The palmos-index-names command fills the
+   cache by reading the ROM and finding the names itself.  The table of
+   names is in palmos-names.c.  */
+
+/* Only addresses at or above this are cached, zero if unknown yet.  */
+static CORE_ADDR rom_base = 0;
+
+/* The file the cache is kept in, or NULL if not yet determined.  */
+static char *macsbug_cache_file = NULL;
+
+/* Directory in which the per-ROM cache files live.  */
+static char *macsbug_cache_dir = NULL;
+
+/* Forget everything; called when a new connection may mean a new ROM.  */
+
+static void
+clear_macsbug_names ()
+{
+  free_macsbug_names ();
+
+  rom_base = 0;
+  xfree (macsbug_cache_file);
+  macsbug_cache_file = NULL;
+}
+
+/* Append an entry to the cache file.  */
+
+static void
+save_macsbug_name (FILE *f, CORE_ADDR start, CORE_ADDR end, const char *name)
+{
+  fprintf (f, "%08lx %08lx %s\n", (unsigned long) start,
+	   (unsigned long) end, name);
+}
+
+/* Work out which ROM the target is running, and load what we already know
+   about it.  The ROM is identified by the trap dispatcher's address (taken
+   from the trap #15 vector) and a CRC of the code there; ROM routines are
+   taken to be those in the same 16 megabyte region as the dispatcher.  */
+
+static void
+load_macsbug_names ()
+{
+  unsigned char vector[4], code[1024];
+  CORE_ADDR dispatcher;
+  unsigned short crc;
+  char buf[300], name[256];
+  unsigned long start, end;
+  FILE *f;
+
+  if (macsbug_cache_file != NULL)
+    return;
+
+  /* Don't keep trying if the target won't tell us.  */
+  macsbug_cache_file = xstrdup ("");
+
+  if (remote_read_bytes (0xbc, (char *) vector, 4) != 4)
+    return;
+  dispatcher = get_long (vector);
+  if (remote_read_bytes (dispatcher, (char *) code, sizeof code)
+      != sizeof code)
+    return;
+  crc = docrc (code, sizeof code);
+
+  rom_base = dispatcher & ~(CORE_ADDR) 0xffffff;
+
+  if (macsbug_cache_dir == NULL || macsbug_cache_dir[0] == '\0')
+    return;
+
+  sprintf (buf, "/rom-%08lx-%04x.names", (unsigned long) dispatcher, crc);
+  xfree (macsbug_cache_file);
+  macsbug_cache_file = concat (macsbug_cache_dir, buf, NULL);
+
+  if ((f = fopen (macsbug_cache_file, "r")) == NULL)
+    return;
+
+  while (fgets (buf, sizeof buf, f))
+    if (sscanf (buf, "%lx %lx %255s", &start, &end, name) == 3
+	&& start < end && start >= rom_base)
+      add_macsbug_name (start, end, name);
+
+  fclose (f);
+}
+
+/* Open the cache file for appending, creating its directory if need be.
+   Returns NULL if there's nowhere to save to.  */
+
+static FILE *
+open_macsbug_cache ()
+{
+  if (macsbug_cache_file == NULL || macsbug_cache_file[0] == '\0')
+    return NULL;
+
+  mkdir (macsbug_cache_dir, 0777);
+  return fopen (macsbug_cache_file, "a");
+}
+
+static void
+close_macsbug_cache (void *f)
+{
+  fclose ((FILE *) f);
+}
+
 char *
 last_chance_lookup_by_pc (CORE_ADDR pc)
 {
-  return remote_get_macsbug_name (pc);
+  CORE_ADDR start, end;
+  char *name;
+  int i;
+  FILE *f;
+
+  load_macsbug_names ();
+
+  if (rom_base != 0 && pc >= rom_base)
+    {
+      if ((i = find_macsbug_name (pc)) >= 0)
+	return macsbug_names[i].name;
+    }
+
+  start = end = 0;
+  name = remote_get_macsbug_name (pc, &start, &end);
+
+  if (rom_base == 0 || pc < rom_base
+      || (name != NULL && strcmp (name, "funky packet") == 0))
+    return name;
+
+  if (name == NULL)
+    {
+      /* Remember that there's nothing here, but only for this session.  */
+      add_macsbug_name (pc, pc + 1, NULL);
+      return NULL;
+    }
+
+  if (! (start <= pc && pc < end))
+    start = pc, end = pc + 1;
+
+  name = add_macsbug_name (start, end, name);
+
+  if ((f = open_macsbug_cache ()) != NULL)
+    {
+      save_macsbug_name (f, start, end, name);
+      fclose (f);
+    }
+
+  return name;
+}
+
+/* If there's a MacsBug name at P (which has LEN bytes available), return
+   its length, put it in NAME, and set *SIZEP to the length of the whole
+   name block, including the constant data which follows it.  Otherwise
+   return 0.  Both the fixed 8 or 16 character and the variable length
+   formats are recognised.  */
+
+static int
+macsbug_name_at (unsigned char *p, int len, char *name, int *sizep)
+{
+  int n, i, size;
+  unsigned char *text;
+
+  if (len < 2 || p[0] < 0x80)
+    return 0;
+
+  if (p[0] >= 0x80 && p[0] < 0xa0)
+    {
+      /* Variable length: 0x80 and a length byte, or 0x80 + length.  */
+      if (p[0] == 0x80)
+	n = p[1], text = p + 2;
+      else
+	n = p[0] - 0x80, text = p + 1;
+    }
+  else
+    {
+      /* Fixed length, with the high bit of the first (and of the second,
+	 for 16 characters) set.  */
+      n = (p[1] & 0x80) ? 16 : 8;
+      text = p;
+    }
+
+  size = (text - p) + n;
+  size = (size + 1) & ~1;
+  if (n == 0 || size + 2 > len)
+    return 0;
+
+  for (i = 0; i < n; i++)
+    {
+      int c = text[i] & 0x7f;
+      if (! (isalnum (c) || c == '_' || c == '%' || c == '.'))
+	return 0;
+      name[i] = c;
+    }
+  name[n] = '\0';
+
+  if (text == p + 2 || text == p + 1)
+    size += 2 + get_short (p + size);
+
+  *sizep = (size + 1) & ~1;
+  return n;
+}
+
+/* Walk [START, END) on the target, finding each routine by the MacsBug
+   name which follows its final RTS, JMP (A0) or RTE, and add them all to
+   the cache.  */
+
+static void
+palmos_index_names_command (args, from_tty)
+     char *args;
+     int from_tty;
+{
+  /* Enough for the longest routine tail: an opcode, a name block and up
+     to 64K of constant data is not worth chasing across chunks.  */
+  enum { CHUNK = 16384, SLOP = 300 };
+  unsigned char *buf;
+  char **argv, name[256];
+  CORE_ADDR start, end, addr, routine;
+  struct cleanup *old_chain;
+  FILE *f;
+  int count = 0;
+
+  if (remote_desc == NULL)
+    error ("Not connected to a Palm OS target.");
+  if (args == NULL)
+    error_no_arg ("start and end addresses of the ROM code to scan");
+
+  argv = buildargv (args);
+  if (argv == NULL)
+    nomem (0);
+  old_chain = make_cleanup_freeargv (argv);
+  if (argv[0] == NULL || argv[1] == NULL || argv[2] != NULL)
+    error ("Usage: palmos-index-names START END");
+  start = parse_and_eval_address (argv[0]) & ~(CORE_ADDR) 1;
+  end = parse_and_eval_address (argv[1]);
+  if (start >= end)
+    error ("START must be below END.");
+
+  load_macsbug_names ();
+  if (rom_base == 0 || start < rom_base)
+    error ("Only ROM code, at or above 0x%lx, can be indexed.",
+	   (unsigned long) rom_base);
+
+  buf = xmalloc (CHUNK + SLOP);
+  make_cleanup (xfree, buf);
+  f = open_macsbug_cache ();
+  if (f != NULL)
+    make_cleanup (close_macsbug_cache, f);
+
+  routine = start;
+  addr = start;
+  while (addr < end)
+    {
+      int len, got, i;
+
+      QUIT;
+
+      len = (end - addr > CHUNK) ? CHUNK : end - addr;
+      got = remote_read_bytes (addr, (char *) buf, len + SLOP);
+      if (got < len)
+	error ("Couldn't read target memory at 0x%lx.",
+	       (unsigned long) (addr + got));
+
+      for (i = 0; i < len; i += 2)
+	{
+	  unsigned int op = get_short (buf + i);
+	  int size;
+
+	  if ((op == 0x4e75 || op == 0x4ed0 || op == 0x4e73)
+	      && macsbug_name_at (buf + i + 2, got - i - 2, name, &size))
+	    {
+	      CORE_ADDR tail = addr + i + 2;
+
+	      add_macsbug_name (routine, tail, name);
+	      if (f != NULL)
+		save_macsbug_name (f, routine, tail, name);
+	      count++;
+
+	      routine = tail + size;
+	      i += size;
+	    }
+	}
+
+      /* A name block may have carried us past the end of the chunk.  */
+      addr = (routine > addr + len) ? routine : addr + len;
+
+      if (from_tty && ((addr - start) & 0xffff) < CHUNK)
+	{
+	  printf_filtered ("\r0x%08lx: %d names", (unsigned long) addr, count);
+	  gdb_flush (gdb_stdout);
+	}
+    }
+
+  do_cleanups (old_chain);
+
+  if (from_tty)
+    printf_filtered ("\nIndexed %d MacsBug names.\n", count);
 }
 
 /* Read memory data directly from the remote machine.
@@ -1100,6 +1919,12 @@ remote_mourn_pilot ()
   remote_mourn_1 (&pilot_ops);
 }
 
+static void
+remote_async_mourn ()
+{
+  remote_mourn_1 (&palmos_async_ops);
+}
+
 static void
 remote_mourn_1 (struct target_ops *ops)
 {
@@ -1202,7 +2027,7 @@ remote_remove_wbreakpoint ()
 
 /* Define the target subroutine names */
 
-struct target_ops palmos_ops, pilot_ops;
+struct target_ops palmos_ops, pilot_ops, palmos_async_ops;
 
 static void
 init_palmos_ops (void)
@@ -1290,4 +2115,65 @@ _initialize_remote_palmos ()
   pilot_ops.to_open = remote_open_pilot;
   pilot_ops.to_mourn_inferior = remote_mourn_pilot;
   add_target (&pilot_ops);
+
+  palmos_async_ops = palmos_ops;
+  palmos_async_ops.to_shortname = "palmos-async";
+  palmos_async_ops.to_longname =
+    "Remote target in Palm OS-specific protocol, with asynchronous support";
+  palmos_async_ops.to_doc = "\
+Use a Palm OS device via a serial line, or emulator via TCP, using\n\
+a Palm OS-specific protocol, and handle its debug messages from the\n\
+event loop while it runs.  Specify the device it is connected to\n\
+(e.g., /dev/ttyS0); localhost:2000 is assumed by default.";
+  palmos_async_ops.to_open = remote_async_open;
+  palmos_async_ops.to_detach = remote_async_detach;
+  palmos_async_ops.to_resume = remote_async_resume;
+  palmos_async_ops.to_kill = remote_async_kill;
+  palmos_async_ops.to_mourn_inferior = remote_async_mourn;
+  palmos_async_ops.to_terminal_inferior = remote_async_terminal_inferior;
+  palmos_async_ops.to_terminal_ours = remote_async_terminal_ours;
+  palmos_async_ops.to_stop = remote_stop;
+  palmos_async_ops.to_can_async_p = remote_can_async_p;
+  palmos_async_ops.to_is_async_p = remote_is_async_p;
+  palmos_async_ops.to_async = remote_async;
+  palmos_async_ops.to_async_mask_value = 1;
+  add_target (&palmos_async_ops);
+
+  add_show_from_set
+    (add_set_cmd ("palmos-log-file", class_support, var_string_noescape,
+		  (char *) &palmos_log_file,
+		  "Set the file to which the target's debug messages are \
+appended.\n\
+With no argument, they are only shown on the terminal.",
+		  &setlist),
+     &showlist);
+
+  add_show_from_set
+    (add_set_cmd ("palmos-log-rate", class_support, var_zinteger,
+		  (char *) &palmos_log_rate,
+		  "Set how many lines of the target's debug messages are shown \
+per second.\n\
+Lines beyond this are not shown on the terminal, though they still go to \
+the palmos-log-file.  Zero means no limit.",
+		  &setlist),
+     &showlist);
+
+  if (getenv ("HOME") != NULL)
+    macsbug_cache_dir = concat (getenv ("HOME"), "/.palmos-gdb", NULL);
+
+  add_show_from_set
+    (add_set_cmd ("palmos-name-cache", class_support, var_string_noescape,
+		  (char *) &macsbug_cache_dir,
+		  "Set the directory in which MacsBug names are cached.\n\
+A file for each ROM image holds the names of its routines, so that they \
+need not be looked up on the target.  With no argument, names are only \
+cached for the current session.",
+		  &setlist),
+     &showlist);
+
+  add_com ("palmos-index-names", class_support, palmos_index_names_command,
+	   "Find the MacsBug names in the target's ROM code between START \
+and END.\n\
+The names are cached, so that backtraces through the OS don't need to ask \
+the target for them.");
 }
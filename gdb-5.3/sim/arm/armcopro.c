@@ -526,6 +526,18 @@ XScale_check_memacc (ARMul_State * state, ARMword * address, int store)
     }
 }
 
+/* Returns non-zero if XScale_check_memacc would neither relocate nor trap
+   an aligned access, so that the memory model may skip calling it.  */
+
+int
+XScale_memacc_passive (ARMul_State * state ATTRIBUTE_UNUSED)
+{
+  /* Called for every instruction fetch, so read the registers directly
+     rather than through read_cp15_reg.  */
+  return (XScale_cp15_opcode_2_is_0_Regs[13] & 0xfe000000) == 0
+    && (XScale_cp15_DBCON & (ARMul_CP15_DBCON_E0 | ARMul_CP15_DBCON_E1)) == 0;
+}
+
 /* Set the XScale FSR and FAR registers.  */
 
 void
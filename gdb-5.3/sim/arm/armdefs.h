@@ -136,6 +136,8 @@ struct ARMul_State
   unsigned is_v5e;		/* Are we emulating a v5e architecture ?  */
   unsigned is_XScale;		/* Are we emulating an XScale architecture ?  */
   unsigned verbose;		/* Print various messages like the banner */
+
+  struct ARMul_Profile *Prof;	/* profiler data, or NULL when not profiling */
 };
 
 #define ResetPin NresetSig
@@ -332,6 +334,31 @@ extern ARMword ARMul_MemAccess (ARMul_State * state, ARMword, ARMword,
 				ARMword, ARMword, ARMword, ARMword, ARMword,
 				ARMword, ARMword, ARMword);
 
+/***************************************************************************\
+*                 Definitons of things in the profiler                      *
+\***************************************************************************/
+
+typedef struct
+{
+  char *gmon_file;		/* gprof histogram and call graph, or NULL */
+  char *mem_file;		/* memory access histogram, or NULL */
+  unsigned granule_bits;	/* log2 of the memory histogram granule */
+  unsigned nwait;		/* wait states added to each N cycle */
+  unsigned swait;		/* wait states added to each S cycle */
+  unsigned long freq;		/* core clock in Hz, for gprof's time base */
+} ARMul_ProfileOptions;
+
+extern unsigned ARMul_ProfileInit (ARMul_State * state,
+				   ARMul_ProfileOptions * opts);
+extern void ARMul_ProfileExit (ARMul_State * state);
+extern void ARMul_ProfileInstr (ARMul_State * state, ARMword pc);
+extern void ARMul_ProfileRefill (ARMul_State * state);
+extern void ARMul_ProfileArc (ARMul_State * state, ARMword frompc,
+			      ARMword selfpc);
+extern void ARMul_ProfileMemAccess (ARMul_State * state, ARMword address,
+				    int write);
+extern ARMdword ARMul_ProfileCycles (ARMul_State * state);
+
 /***************************************************************************\
 *            Definitons of things in the co-processor interface             *
 \***************************************************************************/
@@ -382,6 +409,7 @@ extern void ARMul_CoProAttach (ARMul_State * state, unsigned number,
 extern void ARMul_CoProDetach (ARMul_State * state, unsigned number);
 extern void XScale_check_memacc (ARMul_State * state, ARMword * address,
 				 int store);
+extern int XScale_memacc_passive (ARMul_State * state);
 extern void XScale_set_fsr_far (ARMul_State * state, ARMword fsr, ARMword far);
 extern int XScale_debug_moe (ARMul_State * state, int moe);
 
@@ -37,6 +37,7 @@ static void     LoadMult            (ARMul_State *, ARMword, ARMword, ARMword);
 static void     StoreMult           (ARMul_State *, ARMword, ARMword, ARMword);
 static void     LoadSMult           (ARMul_State *, ARMword, ARMword, ARMword);
 static void     StoreSMult          (ARMul_State *, ARMword, ARMword, ARMword);
+static unsigned MultiplyCycles      (ARMul_State *, ARMword, int);
 static unsigned Multiply64          (ARMul_State *, ARMword, int, int);
 static unsigned MultiplyAdd64       (ARMul_State *, ARMword, int, int);
 static void     Handle_Load_Double  (ARMul_State *, ARMword);
@@ -60,6 +61,24 @@ extern int (*ui_loop_hook) (int);
 
 extern int stop_simulator;
 
+#ifdef MODET
+/* ARMul_ThumbDecode translates a Thumb instruction into an ARM one.  When
+   it does so the result depends only on the halfword and on whether this
+   is a v5 core, so remember it for each PC and reuse it for as long as the
+   same halfword is fetched from there.  */
+#define THUMB_CACHE_SIZE 4096
+
+/* Set in the key of every filled entry.  */
+#define THUMB_CACHE_VALID 0x80000000
+
+static struct
+{
+  ARMword pc;
+  ARMword key;		/* halfword, v5 flag, and THUMB_CACHE_VALID */
+  ARMword instr;	/* equivalent ARM instruction */
+} thumb_cache[THUMB_CACHE_SIZE];
+#endif
+
 /* Short-hand macros for LDR/STR.  */
 
 /* Store post decrement writeback.  */
@@ -369,6 +388,8 @@ ARMul_Emulate26 (ARMul_State * state)
 	  decoded = ARMul_LoadInstrS (state, pc + (isize), isize);
 	  loaded  = ARMul_LoadInstrS (state, pc + (isize * 2), isize);
 	  NORMALCYCLE;
+	  if (state->Prof != NULL)
+	    ARMul_ProfileRefill (state);
 	  break;
 	}
 
@@ -435,27 +456,39 @@ ARMul_Emulate26 (ARMul_State * state)
       if (TFLAG)
 	{
 	  ARMword new;
+	  ARMword key;
+	  unsigned slot;
 
-	  /* Check if in Thumb mode.  */
-	  switch (ARMul_ThumbDecode (state, pc, instr, &new))
-	    {
-	    case t_undefined:
-	      /* This is a Thumb instruction.  */
-	      ARMul_UndefInstr (state, instr);
-	      goto donext;
+	  key = (state->bigendSig ? instr >> 16 : instr & 0xffff)
+	    | (state->is_v5 << 16) | THUMB_CACHE_VALID;
+	  slot = (pc >> 1) & (THUMB_CACHE_SIZE - 1);
+
+	  if (thumb_cache[slot].pc == pc && thumb_cache[slot].key == key)
+	    instr = thumb_cache[slot].instr;
+	  else
+	    /* Check if in Thumb mode.  */
+	    switch (ARMul_ThumbDecode (state, pc, instr, &new))
+	      {
+	      case t_undefined:
+		/* This is a Thumb instruction.  */
+		ARMul_UndefInstr (state, instr);
+		goto donext;
 
-	    case t_branch:
-	      /* Already processed.  */
-	      goto donext;
+	      case t_branch:
+		/* Already processed.  */
+		goto donext;
 
-	    case t_decoded:
-	      /* ARM instruction available.  */
-	      instr = new;
-	      /* So continue instruction decoding.  */
-	      break;
-	    default:
-	      break;
-	    }
+	      case t_decoded:
+		/* ARM instruction available.  */
+		thumb_cache[slot].pc = pc;
+		thumb_cache[slot].key = key;
+		thumb_cache[slot].instr = new;
+		instr = new;
+		/* So continue instruction decoding.  */
+		break;
+	      default:
+		break;
+	      }
 	}
 #endif
 
@@ -728,12 +761,7 @@ check_PMUintr:
 		  else
 		    UNDEF_MULPCDest;
 
-		  for (dest = 0, temp = 0; dest < 32; dest ++)
-		    if (rhs & (1L << dest))
-		      temp = dest;
-
-		  /* Mult takes this many/2 I cycles.  */
-		  ARMul_Icycles (state, ARMul_MultTable[temp], 0L);
+		  ARMul_Icycles (state, MultiplyCycles (state, rhs, 0), 0L);
 		}
 	      else
 		{
@@ -772,12 +800,7 @@ check_PMUintr:
 		  else
 		    UNDEF_MULPCDest;
 
-		  for (dest = 0, temp = 0; dest < 32; dest ++)
-		    if (rhs & (1L << dest))
-		      temp = dest;
-
-		  /* Mult takes this many/2 I cycles.  */
-		  ARMul_Icycles (state, ARMul_MultTable[temp], 0L);
+		  ARMul_Icycles (state, MultiplyCycles (state, rhs, 0), 0L);
 		}
 	      else
 		{
@@ -811,12 +834,7 @@ check_PMUintr:
 		  else
 		    UNDEF_MULPCDest;
 
-		  for (dest = 0, temp = 0; dest < 32; dest ++)
-		    if (rhs & (1L << dest))
-		      temp = dest;
-
-		  /* Mult takes this many/2 I cycles.  */
-		  ARMul_Icycles (state, ARMul_MultTable[temp], 0L);
+		  ARMul_Icycles (state, MultiplyCycles (state, rhs, 1), 0L);
 		}
 	      else
 		{
@@ -855,12 +873,7 @@ check_PMUintr:
 		  else
 		    UNDEF_MULPCDest;
 
-		  for (dest = 0, temp = 0; dest < 32; dest ++)
-		    if (rhs & (1L << dest))
-		      temp = dest;
-
-		  /* Mult takes this many/2 I cycles.  */
-		  ARMul_Icycles (state, ARMul_MultTable[temp], 0L);
+		  ARMul_Icycles (state, MultiplyCycles (state, rhs, 1), 0L);
 		}
 	      else
 		{
@@ -3544,6 +3557,9 @@ check_PMUintr:
     donext:
 #endif
 
+      if (state->Prof != NULL)
+	ARMul_ProfileInstr (state, pc);
+
 #ifdef NEED_UI_LOOP_HOOK
       if (ui_loop_hook != NULL && ui_loop_hook_counter-- < 0)
 	{
@@ -4732,6 +4748,37 @@ Add32 (ARMword a1, ARMword a2, int *carry)
   return result;
 }
 
+/* This function returns the number of I cycles taken by a MUL or MLA
+   whose multiplier is RS.  The v4 cores, such as the ARM7TDMI, retire
+   eight bits of the multiplier per cycle and stop early once the rest is
+   all zeros or all ones; MLA takes one more cycle for the addition.
+   Older cores take one cycle for every two bits of the multiplier.  */
+
+static unsigned
+MultiplyCycles (ARMul_State * state, ARMword rs, int accumulate)
+{
+  unsigned m;
+
+  if (state->is_v4)
+    {
+      if ((rs & 0xFFFFFF00) == 0 || (rs & 0xFFFFFF00) == 0xFFFFFF00)
+	m = 1;
+      else if ((rs & 0xFFFF0000) == 0 || (rs & 0xFFFF0000) == 0xFFFF0000)
+	m = 2;
+      else if ((rs & 0xFF000000) == 0 || (rs & 0xFF000000) == 0xFF000000)
+	m = 3;
+      else
+	m = 4;
+
+      return m + (accumulate ? 1 : 0);
+    }
+
+  for (m = 0; rs != 0; m++)
+    rs >>= 1;
+
+  return ARMul_MultTable[m ? m - 1 : 0];
+}
+
 /* This function does the work of multiplying
    two 32bit values to give a 64bit result.  */
 
@@ -0,0 +1,486 @@
+/*  armprof.c -- ARMulator execution profiler.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
+
+/* This file contains a per-PC cycle profiler and a memory access histogram
+for the ARMulator.  Cycles are charged using the ARM7TDMI bus timing which
+the emulator already models: every S, N, I and C cycle costs one clock, plus
+any configured wait states for S and N memory cycles.  The refill after a
+taken branch is charged to the branch, so a branch costs 2S + 1N as on the
+real core.  Counts are kept per halfword of PC in pages allocated on demand,
+in the same way as armvirt.c allocates memory.  At exit the PC histogram and
+the call arcs seen are written as a gprof-compatible gmon.out, and the memory
+histogram as a plain text table. */
+
+#include <string.h>
+#include "armdefs.h"
+#include "armemu.h"
+#include "ansidecl.h"
+
+#define PROF_PAGEBITS 16
+#define PROF_NUMPAGES (1 << (32 - PROF_PAGEBITS))
+#define PROF_PAGESLOTS (1 << (PROF_PAGEBITS - 1))	/* halfwords per page */
+#define PROF_PAGEOFFSET ((1 << PROF_PAGEBITS) - 1)
+
+#define ARC_HASHSIZE 4096
+
+/* gprof can't cope with histograms bigger than this many bins, so larger
+   PC ranges are folded into wider bins.  */
+#define MAX_HIST_BINS (1024 * 1024)
+
+struct ProfArc
+{
+  ARMword frompc, selfpc;
+  unsigned long count;
+  struct ProfArc *next;
+};
+
+struct ARMul_Profile
+{
+  ARMul_ProfileOptions opts;
+
+  ARMdword **pcpages;		/* cycles per PC halfword */
+  unsigned long **mempages;	/* read and write counts per granule */
+  unsigned memslots;		/* granules per page */
+
+  struct ProfArc *arcs[ARC_HASHSIZE];
+
+  ARMdword lastcycles;		/* clocks at the last attribution */
+  ARMword lastpc;
+  int havelast;
+
+  ARMword lowpc, highpc;	/* range of PCs seen */
+};
+
+/***************************************************************************\
+*                 Total clocks so far, with wait states                     *
+\***************************************************************************/
+
+static ARMdword
+Clocks (ARMul_State * state)
+{
+  struct ARMul_Profile *prof = state->Prof;
+
+  return (ARMdword) state->NumScycles * (1 + prof->opts.swait)
+    + (ARMdword) state->NumNcycles * (1 + prof->opts.nwait)
+    + state->NumIcycles + state->NumCcycles;
+}
+
+static void
+ChargePC (struct ARMul_Profile *prof, ARMword pc, ARMdword cycles)
+{
+  ARMdword *pageptr;
+  ARMword page = pc >> PROF_PAGEBITS;
+
+  pageptr = prof->pcpages[page];
+  if (pageptr == NULL)
+    {
+      pageptr = (ARMdword *) calloc (PROF_PAGESLOTS, sizeof (ARMdword));
+      if (pageptr == NULL)
+	{
+	  perror ("ARMulator can't allocate profile page");
+	  exit (12);
+	}
+      prof->pcpages[page] = pageptr;
+    }
+
+  pageptr[(pc & PROF_PAGEOFFSET) >> 1] += cycles;
+
+  if (pc < prof->lowpc)
+    prof->lowpc = pc;
+  if (pc > prof->highpc)
+    prof->highpc = pc;
+}
+
+/***************************************************************************\
+*                      Initialise the profiler                              *
+\***************************************************************************/
+
+unsigned
+ARMul_ProfileInit (ARMul_State * state, ARMul_ProfileOptions * opts)
+{
+  struct ARMul_Profile *prof;
+
+  prof = (struct ARMul_Profile *) calloc (1, sizeof (struct ARMul_Profile));
+  if (prof == NULL)
+    return FALSE;
+
+  prof->opts = *opts;
+  if (prof->opts.granule_bits > PROF_PAGEBITS)
+    prof->opts.granule_bits = PROF_PAGEBITS;
+  if (prof->opts.freq == 0)
+    prof->opts.freq = 1;
+  prof->memslots = 1 << (PROF_PAGEBITS - prof->opts.granule_bits);
+
+  prof->pcpages = (ARMdword **) calloc (PROF_NUMPAGES, sizeof (ARMdword *));
+  if (prof->opts.mem_file)
+    prof->mempages = (unsigned long **) calloc (PROF_NUMPAGES,
+						sizeof (unsigned long *));
+
+  if (prof->pcpages == NULL || (prof->opts.mem_file && !prof->mempages))
+    {
+      free (prof->pcpages);
+      free (prof->mempages);
+      free (prof);
+      return FALSE;
+    }
+
+  prof->lowpc = 0xffffffff;
+  prof->highpc = 0;
+
+  state->Prof = prof;
+  ARMul_ConsolePrint (state, ", Profiler");
+
+  return TRUE;
+}
+
+/***************************************************************************\
+*         Charge the cycles since the last instruction to this PC           *
+\***************************************************************************/
+
+void
+ARMul_ProfileInstr (ARMul_State * state, ARMword pc)
+{
+  struct ARMul_Profile *prof = state->Prof;
+  ARMdword now = Clocks (state);
+
+  pc &= ~1L;
+  ChargePC (prof, pc, now - prof->lastcycles);
+  prof->lastcycles = now;
+  prof->lastpc = pc;
+  prof->havelast = TRUE;
+
+  /* A taken branch that wrote the return address into the link register
+     is a call, whether it was a BL, a Thumb BL pair, or a MOV LR,PC
+     followed by a BX or a load into the PC.  */
+  if ((state->NextInstr & PRIMEPIPE)
+      && (state->Reg[14] & ~1L) == pc + 4)
+    ARMul_ProfileArc (state, pc, state->Reg[15]);
+}
+
+/***************************************************************************\
+*    Charge a pipeline refill to the branch that caused it, leaving the     *
+*    sequential fetch of the branch target to the target instruction        *
+\***************************************************************************/
+
+void
+ARMul_ProfileRefill (ARMul_State * state)
+{
+  struct ARMul_Profile *prof = state->Prof;
+  ARMdword now = Clocks (state);
+  ARMdword target = 1 + prof->opts.swait;
+
+  if (prof->havelast && now - prof->lastcycles > target)
+    {
+      ChargePC (prof, prof->lastpc, now - prof->lastcycles - target);
+      prof->lastcycles = now - target;
+    }
+}
+
+/***************************************************************************\
+*                         Record a call graph arc                           *
+\***************************************************************************/
+
+void
+ARMul_ProfileArc (ARMul_State * state, ARMword frompc, ARMword selfpc)
+{
+  struct ARMul_Profile *prof = state->Prof;
+  struct ProfArc *arc;
+  unsigned hash;
+
+  selfpc &= ~1L;
+  hash = ((frompc >> 1) ^ (selfpc >> 3)) % ARC_HASHSIZE;
+
+  for (arc = prof->arcs[hash]; arc != NULL; arc = arc->next)
+    if (arc->frompc == frompc && arc->selfpc == selfpc)
+      {
+	arc->count++;
+	return;
+      }
+
+  arc = (struct ProfArc *) malloc (sizeof (struct ProfArc));
+  if (arc == NULL)
+    return;
+
+  arc->frompc = frompc;
+  arc->selfpc = selfpc;
+  arc->count = 1;
+  arc->next = prof->arcs[hash];
+  prof->arcs[hash] = arc;
+}
+
+/***************************************************************************\
+*                    Count a data access for the histogram                  *
+\***************************************************************************/
+
+void
+ARMul_ProfileMemAccess (ARMul_State * state, ARMword address, int write)
+{
+  struct ARMul_Profile *prof = state->Prof;
+  unsigned long *pageptr;
+  ARMword page = address >> PROF_PAGEBITS;
+
+  if (prof->mempages == NULL)
+    return;
+
+  pageptr = prof->mempages[page];
+  if (pageptr == NULL)
+    {
+      pageptr = (unsigned long *) calloc (2 * prof->memslots,
+					  sizeof (unsigned long));
+      if (pageptr == NULL)
+	{
+	  perror ("ARMulator can't allocate profile page");
+	  exit (12);
+	}
+      prof->mempages[page] = pageptr;
+    }
+
+  pageptr[2 * ((address & PROF_PAGEOFFSET) >> prof->opts.granule_bits)
+	  + (write ? 1 : 0)]++;
+}
+
+/***************************************************************************\
+*                      Writing the gmon.out file                            *
+\***************************************************************************/
+
+static void
+PutWord32 (ARMul_State * state, FILE * f, ARMword val)
+{
+  unsigned char buf[4];
+
+  if (state->bigendSig == HIGH)
+    {
+      buf[0] = val >> 24;
+      buf[1] = val >> 16;
+      buf[2] = val >> 8;
+      buf[3] = val;
+    }
+  else
+    {
+      buf[3] = val >> 24;
+      buf[2] = val >> 16;
+      buf[1] = val >> 8;
+      buf[0] = val;
+    }
+
+  fwrite (buf, 1, 4, f);
+}
+
+static void
+PutWord16 (ARMul_State * state, FILE * f, unsigned val)
+{
+  unsigned char buf[2];
+
+  if (state->bigendSig == HIGH)
+    {
+      buf[0] = val >> 8;
+      buf[1] = val;
+    }
+  else
+    {
+      buf[1] = val >> 8;
+      buf[0] = val;
+    }
+
+  fwrite (buf, 1, 2, f);
+}
+
+static ARMdword
+PCCycles (struct ARMul_Profile *prof, ARMword pc)
+{
+  ARMdword *pageptr = prof->pcpages[pc >> PROF_PAGEBITS];
+
+  return pageptr ? pageptr[(pc & PROF_PAGEOFFSET) >> 1] : 0;
+}
+
+static int
+WriteGmon (ARMul_State * state, struct ARMul_Profile *prof)
+{
+  FILE *f;
+  ARMword lowpc, highpc, binsize, pc;
+  unsigned long nbins, bin, i;
+  ARMdword *bins, maxcycles, scale;
+  unsigned long hz;
+  static const char dimension[15] = "seconds";
+
+  f = fopen (prof->opts.gmon_file, "wb");
+  if (f == NULL)
+    {
+      perror (prof->opts.gmon_file);
+      return FALSE;
+    }
+
+  fwrite ("gmon", 1, 4, f);
+  PutWord32 (state, f, 1);
+  for (i = 0; i < 3; i++)
+    PutWord32 (state, f, 0);
+
+  if (prof->lowpc <= prof->highpc)
+    {
+      /* Bins are a whole number of halfwords, and grow in powers of two
+         until the histogram is a size gprof can read.  */
+      lowpc = prof->lowpc;
+      highpc = prof->highpc + 2;
+      for (binsize = 2; (highpc - lowpc) / binsize > MAX_HIST_BINS;)
+	binsize <<= 1;
+      lowpc &= ~(binsize - 1);
+      nbins = (highpc - lowpc + binsize - 1) / binsize;
+      highpc = lowpc + nbins * binsize;
+
+      bins = (ARMdword *) calloc (nbins, sizeof (ARMdword));
+      if (bins == NULL)
+	{
+	  fclose (f);
+	  return FALSE;
+	}
+
+      maxcycles = 0;
+      for (pc = lowpc; pc != highpc; pc += 2)
+	{
+	  bin = (pc - lowpc) / binsize;
+	  bins[bin] += PCCycles (prof, pc);
+	  if (bins[bin] > maxcycles)
+	    maxcycles = bins[bin];
+	}
+
+      /* gmon.out bins are only 16 bits wide, so scale the counts down and
+         slow the sampling rate to match.  */
+      scale = (maxcycles + 0xfffe) / 0xffff;
+      if (scale == 0)
+	scale = 1;
+      hz = prof->opts.freq / scale;
+      if (hz == 0)
+	hz = 1;
+
+      putc (0, f);		/* GMON_TAG_TIME_HIST */
+      PutWord32 (state, f, lowpc);
+      PutWord32 (state, f, highpc);
+      PutWord32 (state, f, nbins);
+      PutWord32 (state, f, hz);
+      fwrite (dimension, 1, sizeof dimension, f);
+      putc ('s', f);
+
+      for (bin = 0; bin < nbins; bin++)
+	{
+	  ARMdword count = bins[bin] / scale;
+
+	  PutWord16 (state, f, count > 0xffff ? 0xffff : (unsigned) count);
+	}
+
+      free (bins);
+    }
+
+  for (i = 0; i < ARC_HASHSIZE; i++)
+    {
+      struct ProfArc *arc;
+
+      for (arc = prof->arcs[i]; arc != NULL; arc = arc->next)
+	{
+	  putc (1, f);		/* GMON_TAG_CG_ARC */
+	  PutWord32 (state, f, arc->frompc);
+	  PutWord32 (state, f, arc->selfpc);
+	  PutWord32 (state, f, arc->count);
+	}
+    }
+
+  return fclose (f) == 0;
+}
+
+/***************************************************************************\
+*                  Writing the memory access histogram                      *
+\***************************************************************************/
+
+static int
+WriteMemHistogram (struct ARMul_Profile *prof)
+{
+  FILE *f;
+  unsigned long page, slot;
+
+  f = fopen (prof->opts.mem_file, "w");
+  if (f == NULL)
+    {
+      perror (prof->opts.mem_file);
+      return FALSE;
+    }
+
+  fprintf (f, "# %u-byte granules\n# address     reads    writes\n",
+	   1U << prof->opts.granule_bits);
+
+  for (page = 0; page < PROF_NUMPAGES; page++)
+    {
+      unsigned long *pageptr = prof->mempages[page];
+
+      if (pageptr == NULL)
+	continue;
+
+      for (slot = 0; slot < prof->memslots; slot++)
+	if (pageptr[2 * slot] || pageptr[2 * slot + 1])
+	  fprintf (f, "%08lx %9lu %9lu\n",
+		   (page << PROF_PAGEBITS) | (slot << prof->opts.granule_bits),
+		   pageptr[2 * slot], pageptr[2 * slot + 1]);
+    }
+
+  return fclose (f) == 0;
+}
+
+/***************************************************************************\
+*        Write out the results and release the profiler's storage           *
+\***************************************************************************/
+
+void
+ARMul_ProfileExit (ARMul_State * state)
+{
+  struct ARMul_Profile *prof = state->Prof;
+  unsigned long i;
+
+  if (prof == NULL)
+    return;
+
+  if (prof->opts.gmon_file)
+    WriteGmon (state, prof);
+  if (prof->opts.mem_file)
+    WriteMemHistogram (prof);
+
+  for (i = 0; i < PROF_NUMPAGES; i++)
+    {
+      free (prof->pcpages[i]);
+      if (prof->mempages)
+	free (prof->mempages[i]);
+    }
+  free (prof->pcpages);
+  free (prof->mempages);
+
+  for (i = 0; i < ARC_HASHSIZE; i++)
+    while (prof->arcs[i] != NULL)
+      {
+	struct ProfArc *next = prof->arcs[i]->next;
+	free (prof->arcs[i]);
+	prof->arcs[i] = next;
+      }
+
+  free (prof);
+  state->Prof = NULL;
+}
+
+/***************************************************************************\
+*                   Total clocks charged by the profiler                    *
+\***************************************************************************/
+
+ARMdword
+ARMul_ProfileCycles (ARMul_State * state)
+{
+  return state->Prof ? Clocks (state) : 0;
+}
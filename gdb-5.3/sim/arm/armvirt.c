@@ -23,6 +23,13 @@ table. The routines PutWord and GetWord implement this. Pages are never
 freed as they might be needed again. A single area of memory may be
 defined to generate aborts. */
 
+/* The first MemSize bytes, where programs are loaded and armlets live, are
+allocated up front as one flat block, and GetWord and PutWord go straight
+to it without consulting the page table.  Instruction fetches are also
+satisfied from a direct-mapped cache of previously fetched words.  A
+word can only be held in the lines for its own address and for the Thumb
+halfword pairs either side of it, so PutWord discards just those. */
+
 #include "armopts.h"
 #include "armos.h"
 #include "armdefs.h"
@@ -50,8 +57,66 @@ defined to generate aborts. */
 #define PAGEBITS 16
 #define OFFSETBITS 0xffff
 
+/* The flat block is never larger than this.  */
+#define MAXFLATSIZE (64 * 1024 * 1024)
+
+#define ICACHEBITS 13
+#define ICACHESIZE (1 << ICACHEBITS)
+
+/* A line whose tag has this bit set is empty, so fetches from the top
+   half of memory are never cached.  */
+#define ICACHEEMPTY 0x80000000
+
+#define ICACHELINE(mem, address) \
+  (&(mem)->icache[((address) >> 1) & (ICACHESIZE - 1)])
+
+struct ICacheLine
+{
+  ARMword tag;			/* fetch address, plus one for Thumb */
+  ARMword instr;		/* the word ARMul_ReLoadInstr returned */
+};
+
+struct MemModel
+{
+  ARMword *pagetable[NUMPAGES];
+  ARMword *flat;		/* the first flatsize bytes of memory */
+  ARMword flatsize;
+  struct ICacheLine icache[ICACHESIZE];
+};
+
+/* Forget any cached fetches that include the word at ADDRESS.  */
+
+static void
+ICacheInvalidate (struct MemModel *mem, ARMword address)
+{
+  struct ICacheLine *line;
+
+  address &= ~3L;
+
+  line = ICACHELINE (mem, address);
+  if ((line->tag & ~1L) == address)
+    line->tag = ICACHEEMPTY;
+
+  line = ICACHELINE (mem, address + 2);
+  if (line->tag == ((address + 2) | 1))
+    line->tag = ICACHEEMPTY;
+
+  line = ICACHELINE (mem, address - 2);
+  if (line->tag == ((address - 2) | 1))
+    line->tag = ICACHEEMPTY;
+}
+
 int SWI_vector_installed = FALSE;
 
+/* Feed data accesses to the memory histogram when profiling.  */
+#define PROFILE_ACCESS(address, write)				\
+  do								\
+    {								\
+      if (state->Prof != NULL)					\
+	ARMul_ProfileMemAccess (state, (address), (write));	\
+    }								\
+  while (0)
+
 /***************************************************************************\
 *        Get a Word from Virtual Memory, maybe allocating the page          *
 \***************************************************************************/
@@ -59,17 +124,21 @@ int SWI_vector_installed = FALSE;
 static ARMword
 GetWord (ARMul_State * state, ARMword address, int check)
 {
+  struct MemModel *mem = (struct MemModel *) state->MemDataPtr;
   ARMword page;
   ARMword offset;
   ARMword **pagetable;
   ARMword *pageptr;
 
-  if (check)
+  if (check && state->is_XScale)
     XScale_check_memacc (state, &address, 0);
 
+  if (address < mem->flatsize)
+    return mem->flat[address >> 2];
+
   page = address >> PAGEBITS;
   offset = (address & OFFSETBITS) >> 2;
-  pagetable = (ARMword **) state->MemDataPtr;
+  pagetable = mem->pagetable;
   pageptr = *(pagetable + page);
 
   if (pageptr == NULL)
@@ -95,17 +164,29 @@ GetWord (ARMul_State * state, ARMword address, int check)
 static void
 PutWord (ARMul_State * state, ARMword address, ARMword data, int check)
 {
+  struct MemModel *mem = (struct MemModel *) state->MemDataPtr;
   ARMword page;
   ARMword offset;
   ARMword **pagetable;
   ARMword *pageptr;
 
-  if (check)
+  if (check && state->is_XScale)
     XScale_check_memacc (state, &address, 1);
 
+  ICacheInvalidate (mem, address);
+
+  if (address == 0x8)
+    SWI_vector_installed = TRUE;
+
+  if (address < mem->flatsize)
+    {
+      mem->flat[address >> 2] = data;
+      return;
+    }
+
   page = address >> PAGEBITS;
   offset = (address & OFFSETBITS) >> 2;
-  pagetable = (ARMword **) state->MemDataPtr;
+  pagetable = mem->pagetable;
   pageptr = *(pagetable + page);
 
   if (pageptr == NULL)
@@ -120,9 +201,6 @@ PutWord (ARMul_State * state, ARMword address, ARMword data, int check)
       *(pagetable + page) = pageptr;
     }
 
-  if (address == 0x8)
-    SWI_vector_installed = TRUE;
-
   *(pageptr + offset) = data;
 }
 
@@ -133,21 +211,37 @@ PutWord (ARMul_State * state, ARMword address, ARMword data, int check)
 unsigned
 ARMul_MemoryInit (ARMul_State * state, unsigned long initmemsize)
 {
-  ARMword **pagetable;
+  struct MemModel *mem;
+  ARMword flatsize;
   unsigned page;
 
   if (initmemsize)
     state->MemSize = initmemsize;
 
-  pagetable = (ARMword **) malloc (sizeof (ARMword) * NUMPAGES);
+  mem = (struct MemModel *) malloc (sizeof (struct MemModel));
 
-  if (pagetable == NULL)
+  if (mem == NULL)
     return FALSE;
 
   for (page = 0; page < NUMPAGES; page++)
-    *(pagetable + page) = NULL;
+    mem->pagetable[page] = NULL;
+
+  for (page = 0; page < ICACHESIZE; page++)
+    mem->icache[page].tag = ICACHEEMPTY;
+
+  flatsize = (state->MemSize + PAGESIZE - 1) & ~OFFSETBITS;
+  if (flatsize > MAXFLATSIZE)
+    flatsize = MAXFLATSIZE;
+
+  mem->flat = flatsize ? (ARMword *) calloc (flatsize, 1) : NULL;
+  mem->flatsize = mem->flat ? flatsize : 0;
+
+  /* The page table covers the flat block too, for the benefit of
+     anything that still walks it.  */
+  for (page = 0; page < (mem->flatsize >> PAGEBITS); page++)
+    mem->pagetable[page] = mem->flat + (page << (PAGEBITS - 2));
 
-  state->MemDataPtr = (unsigned char *) pagetable;
+  state->MemDataPtr = (unsigned char *) mem;
 
   ARMul_ConsolePrint (state, ", 4 Gb memory");
 
@@ -161,18 +255,18 @@ ARMul_MemoryInit (ARMul_State * state, unsigned long initmemsize)
 void
 ARMul_MemoryExit (ARMul_State * state)
 {
+  struct MemModel *mem = (struct MemModel *) state->MemDataPtr;
   ARMword page;
-  ARMword **pagetable;
   ARMword *pageptr;
 
-  pagetable = (ARMword **) state->MemDataPtr;
-  for (page = 0; page < NUMPAGES; page++)
+  for (page = mem->flatsize >> PAGEBITS; page < NUMPAGES; page++)
     {
-      pageptr = *(pagetable + page);
+      pageptr = mem->pagetable[page];
       if (pageptr != NULL)
 	free ((char *) pageptr);
     }
-  free ((char *) pagetable);
+  free ((char *) mem->flat);
+  free ((char *) mem);
   return;
 }
 
@@ -183,6 +277,11 @@ ARMul_MemoryExit (ARMul_State * state)
 ARMword
 ARMul_ReLoadInstr (ARMul_State * state, ARMword address, ARMword isize)
 {
+  struct MemModel *mem = (struct MemModel *) state->MemDataPtr;
+  struct ICacheLine *line;
+  ARMword tag, instr;
+  int cacheable;
+
 #ifdef ABORTS
   if (address >= LOWABORT && address < HIGHABORT)
     {
@@ -195,6 +294,18 @@ ARMul_ReLoadInstr (ARMul_State * state, ARMword address, ARMword isize)
     }
 #endif
 
+  tag = address | (isize == 2);
+  line = ICACHELINE (mem, address);
+
+  /* The XScale checks can relocate or trap a fetch, so the cache is only
+     used while they are doing nothing.  Misaligned Thumb fetches depend
+     on the endianness, so are only cached when little-endian.  */
+  cacheable = (!state->is_XScale || XScale_memacc_passive (state))
+    && !(isize == 2 && (address & 0x2) && state->bigendSig == HIGH);
+
+  if (cacheable && line->tag == tag)
+    return line->instr;
+
   if ((isize == 2) && (address & 0x2))
     {
       /* We return the next two halfwords: */
@@ -202,12 +313,20 @@ ARMul_ReLoadInstr (ARMul_State * state, ARMword address, ARMword isize)
       ARMword hi = GetWord (state, address + 4, FALSE);
 
       if (state->bigendSig == HIGH)
-	return (lo << 16) | (hi >> 16);
+	instr = (lo << 16) | (hi >> 16);
       else
-	return ((hi & 0xFFFF) << 16) | (lo >> 16);
+	instr = ((hi & 0xFFFF) << 16) | (lo >> 16);
     }
+  else
+    instr = GetWord (state, address, TRUE);
 
-  return GetWord (state, address, TRUE);
+  if (cacheable && !(tag & ICACHEEMPTY))
+    {
+      line->tag = tag;
+      line->instr = instr;
+    }
+
+  return instr;
 }
 
 /***************************************************************************\
@@ -267,6 +386,7 @@ ARMword ARMul_ReadWord (ARMul_State * state, ARMword address)
 ARMword ARMul_LoadWordS (ARMul_State * state, ARMword address)
 {
   state->NumScycles++;
+  PROFILE_ACCESS (address, 0);
 
   return ARMul_ReadWord (state, address);
 }
@@ -278,6 +398,7 @@ ARMword ARMul_LoadWordS (ARMul_State * state, ARMword address)
 ARMword ARMul_LoadWordN (ARMul_State * state, ARMword address)
 {
   state->NumNcycles++;
+  PROFILE_ACCESS (address, 0);
 
   return ARMul_ReadWord (state, address);
 }
@@ -291,6 +412,7 @@ ARMword ARMul_LoadHalfWord (ARMul_State * state, ARMword address)
   ARMword temp, offset;
 
   state->NumNcycles++;
+  PROFILE_ACCESS (address, 0);
 
   temp = ARMul_ReadWord (state, address);
   offset = (((ARMword) state->bigendSig * 2) ^ (address & 2)) << 3;	/* bit offset into the word */
@@ -319,6 +441,7 @@ ARMword ARMul_ReadByte (ARMul_State * state, ARMword address)
 ARMword ARMul_LoadByte (ARMul_State * state, ARMword address)
 {
   state->NumNcycles++;
+  PROFILE_ACCESS (address, 0);
 
   return ARMul_ReadByte (state, address);
 }
@@ -353,6 +476,7 @@ void
 ARMul_StoreWordS (ARMul_State * state, ARMword address, ARMword data)
 {
   state->NumScycles++;
+  PROFILE_ACCESS (address, 1);
 
   ARMul_WriteWord (state, address, data);
 }
@@ -365,6 +489,7 @@ void
 ARMul_StoreWordN (ARMul_State * state, ARMword address, ARMword data)
 {
   state->NumNcycles++;
+  PROFILE_ACCESS (address, 1);
 
   ARMul_WriteWord (state, address, data);
 }
@@ -379,6 +504,7 @@ ARMul_StoreHalfWord (ARMul_State * state, ARMword address, ARMword data)
   ARMword temp, offset;
 
   state->NumNcycles++;
+  PROFILE_ACCESS (address, 1);
 
 #ifdef VALIDATE
   if (address == TUBE)
@@ -424,6 +550,7 @@ void
 ARMul_StoreByte (ARMul_State * state, ARMword address, ARMword data)
 {
   state->NumNcycles++;
+  PROFILE_ACCESS (address, 1);
 
 #ifdef VALIDATE
   if (address == TUBE)
@@ -448,10 +575,12 @@ ARMword ARMul_SwapWord (ARMul_State * state, ARMword address, ARMword data)
   ARMword temp;
 
   state->NumNcycles++;
+  PROFILE_ACCESS (address, 0);
 
   temp = ARMul_ReadWord (state, address);
 
   state->NumNcycles++;
+  PROFILE_ACCESS (address, 1);
 
   PutWord (state, address, data, TRUE);
 
@@ -34,6 +34,7 @@
 #include "armemu.h"
 #include "dbg_rdi.h"
 #include "ansidecl.h"
+#include "libiberty.h"
 #include "sim-utils.h"
 #include "run-sim.h"
 #include "gdb/sim-arm.h"
@@ -57,6 +58,13 @@ static int verbosity;
 /* Non-zero to set big endian mode.  */
 static int big_endian;
 
+/* Non-zero to profile the simulated program, and the profiler's settings.  */
+static int profiling;
+static ARMul_ProfileOptions profile_options =
+  {
+    NULL, NULL, 4, 0, 0, 1000000
+  };
+
 int stop_simulator;
 
 static void
@@ -73,6 +81,8 @@ init ()
       ARMul_OSInit (state);
       ARMul_CoProInit (state);
       state->verbose = verbosity;
+      if (profiling && !ARMul_ProfileInit (state, &profile_options))
+	fprintf (stderr, "sim: unable to allocate profiler\n");
       done = 1;
     }
 }
@@ -341,6 +351,16 @@ sim_info (sd, verbose)
      SIM_DESC sd ATTRIBUTE_UNUSED;
      int verbose ATTRIBUTE_UNUSED;
 {
+  if (state == NULL || state->Prof == NULL)
+    return;
+
+  (*sim_callback->printf_filtered)
+    (sim_callback,
+     "Instructions executed: %lu\n"
+     "Cycles: %lu S, %lu N, %lu I, %lu C; %lu clocks\n",
+     state->NumInstrs, state->NumScycles, state->NumNcycles,
+     state->NumIcycles, state->NumCcycles,
+     (unsigned long) ARMul_ProfileCycles (state));
 }
 
 static int
@@ -504,6 +524,55 @@ typedef struct
 } swi_options;
 
 #define SWI_SWITCH	"--swi-support"
+#define PROFILE_SWITCH	"--profile"
+
+/* Recognise the --profile family of switches.  Returns non-zero if PTR
+   was one of them.  */
+
+static int
+sim_target_parse_profile_switch (ptr)
+     char * ptr;
+{
+  char * value;
+
+  if (strncmp (ptr, PROFILE_SWITCH, sizeof PROFILE_SWITCH - 1) != 0)
+    return 0;
+
+  ptr += sizeof PROFILE_SWITCH - 1;
+  value = strchr (ptr, '=');
+  if (value != NULL)
+    value++;
+
+  if (*ptr == 0 || *ptr == '=')
+    profile_options.gmon_file = xstrdup (value ? value : "gmon.out");
+  else if (strncmp (ptr, "-mem", 4) == 0 && (ptr[4] == 0 || ptr[4] == '='))
+    profile_options.mem_file = xstrdup (value ? value : "armmem.out");
+  else if (strncmp (ptr, "-granule=", 9) == 0)
+    {
+      unsigned long granule = strtoul (value, NULL, 0);
+
+      for (profile_options.granule_bits = 0;
+	   granule > 1;
+	   granule >>= 1)
+	profile_options.granule_bits++;
+    }
+  else if (strncmp (ptr, "-wait=", 6) == 0)
+    {
+      char * end;
+
+      profile_options.nwait = strtoul (value, &end, 0);
+      if (*end == ',')
+	profile_options.swait = strtoul (end + 1, NULL, 0);
+    }
+  else if (strncmp (ptr, "-freq=", 6) == 0)
+    profile_options.freq = strtoul (value, NULL, 0);
+  else
+    return 0;
+
+  profiling = 1;
+  return 1;
+}
+
 
 static swi_options options[] =
   {
@@ -535,6 +604,16 @@ sim_target_parse_command_line (argc, argv)
       if ((ptr == NULL) || (* ptr != '-'))
 	break;
 
+      if (sim_target_parse_profile_switch (ptr))
+	{
+	  /* Remove this option from the argv array.  */
+	  for (arg = i; arg < argc; arg ++)
+	    argv[arg] = argv[arg + 1];
+	  argc --;
+	  i --;
+	  continue;
+	}
+
       if (strncmp (ptr, SWI_SWITCH, sizeof SWI_SWITCH - 1) != 0)
 	continue;
 
@@ -603,6 +682,16 @@ sim_target_display_usage ()
   fprintf (stderr, "%s=<list>  Comma seperated list of SWI protocols to supoport.\n\
                 This list can contain: NONE, DEMON, ANGEL, REDBOOT and/or ALL.\n",
 	   SWI_SWITCH);
+  fprintf (stderr, "%s[=<file>]  Profile cycles per PC using ARM7TDMI timings,\n\
+                writing gprof data to <file> (default gmon.out).\n\
+%s-mem[=<file>]  Write a histogram of data accesses to <file>\n\
+                (default armmem.out).\n\
+%s-granule=<n>  Bytes per memory histogram entry (default 16).\n\
+%s-wait=<n>[,<s>]  Wait states for N (and S) memory cycles.\n\
+%s-freq=<hz>  Core clock for gprof's times (default 1000000,\n\
+                so that a gprof second is a million cycles).\n",
+	   PROFILE_SWITCH, PROFILE_SWITCH, PROFILE_SWITCH, PROFILE_SWITCH,
+	   PROFILE_SWITCH);
 }
 #endif
 
@@ -680,6 +769,9 @@ sim_close (sd, quitting)
   if (myname)
     free (myname);
   myname = NULL;
+
+  if (state != NULL)
+    ARMul_ProfileExit (state);
 }
 
 SIM_RC
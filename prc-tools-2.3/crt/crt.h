@@ -1,5 +1,5 @@
-extern void __do_bhook (UInt16, void *, UInt16);
-extern void __do_ehook (UInt16, void *, UInt16);
+extern void __do_bhook (UInt16, void *, UInt16, int globals);
+extern void __do_ehook (UInt16, void *, UInt16, int globals);
 extern void __do_ctors (void);
 extern void __do_dtors (void);
 
@@ -9,4 +9,11 @@ extern void _RelocateChain (Int16 offset, void *base);
 extern char data_start;
 extern char bss_start;
 
+/* Where _GccLoadCodeAndRelocateData has locked each code resource, for the
+   benefit of the debugger stub.  They are defined in libcrt's code_bases
+   member, and are left zero unless this is a multiple code resource
+   program.  */
+extern void **_GccCodeBases;
+extern UInt16 _GccCodeCount;
+
 #define UNUSED_PARAM  __attribute__ ((unused))
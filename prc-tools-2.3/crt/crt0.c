@@ -47,6 +47,8 @@ start ()
       Int16 mainCmd = appInfo->cmd;
       void *mainPBP = appInfo->cmdPBP;
       UInt16 mainFlags = appInfo->launchFlags;
+      int globals = mainFlags & (sysAppLaunchFlagNewGlobals
+				 | sysAppLaunchFlagSubCall);
       UInt32 result;
 
 #ifdef __OWNGP__
@@ -61,7 +63,7 @@ start ()
       if (mainFlags & sysAppLaunchFlagNewGlobals)
 	_GccRelocateData ();
 
-      __do_bhook (mainCmd, mainPBP, mainFlags);
+      __do_bhook (mainCmd, mainPBP, mainFlags, globals);
 
       if (mainFlags & sysAppLaunchFlagNewGlobals)
 	__do_ctors ();
@@ -71,7 +73,7 @@ start ()
       if (mainFlags & sysAppLaunchFlagNewGlobals)
 	__do_dtors ();
 
-      __do_ehook (mainCmd, mainPBP, mainFlags);
+      __do_ehook (mainCmd, mainPBP, mainFlags, globals);
 
 #ifdef __OWNGP__
       reg_a4 = save_a4;
@@ -57,6 +57,9 @@ _GccLoadCodeAndRelocateData ()
   for (resno = 2; (codeH = DmGet1Resource ('code', resno)) != NULL; resno++)
     *basep++ = MemHandleLock (codeH);
 
+  _GccCodeBases = &__text__;
+  _GccCodeCount = basep - &__text__;
+
   if ((relocH = DmGet1Resource ('rloc', 0)) != NULL) 
     {
       Int16 *chain = MemHandleLock (relocH);
@@ -71,6 +74,79 @@ _GccLoadCodeAndRelocateData ()
     }
 }
 
+#endif
+#ifdef Llazy_dreloc
+
+/* The lazy variant, for programs compiled with -mlazy-sections: a section
+   is locked only when it is first used, at which point the compiled code
+   finds its `__text__SEC' variable still null and calls _GccLoadCodeSection.
+   Sections referred to by the data resource's relocations can't wait for
+   that, so they are locked immediately.  */
+
+extern void *__text__;
+
+/* Allocated by multigen alongside the `__text__SEC' variables.  The handles
+   are looked up at launch, as later on the program may have opened other
+   resource databases.  */
+extern MemHandle _GccCodeHandles[];
+
+void
+_GccLockCodeSection (void **basep)
+{
+  *basep = MemHandleLock (_GccCodeHandles[basep - &__text__]);
+}
+
+/* Called with the address of the `__text__SEC' variable on the stack; this
+   must preserve all registers, which the C function above would not.  */
+asm ("
+	.text
+	.even
+	.globl _GccLoadCodeSection
+_GccLoadCodeSection:
+	movem.l %d0-%d2/%a0-%a1,-(%sp)
+	move.l 24(%sp),-(%sp)
+	bsr.w _GccLockCodeSection
+	addq.l #4,%sp
+	movem.l (%sp)+,%d0-%d2/%a0-%a1
+	rts
+");
+
+void
+_GccLazyLoadCodeAndRelocateData ()
+{
+  void **basep = &__text__;
+  MemHandle codeH, relocH;
+  int resno;
+
+  *basep++ = (void *) &start;
+  for (resno = 2; (codeH = DmGet1Resource ('code', resno)) != NULL; resno++)
+    {
+      _GccCodeHandles[basep - &__text__] = codeH;
+      *basep++ = NULL;
+    }
+
+  _GccCodeBases = &__text__;
+  _GccCodeCount = basep - &__text__;
+
+  if ((relocH = DmGet1Resource ('rloc', 0)) != NULL) 
+    {
+      Int16 *chain = MemHandleLock (relocH);
+      void **baselim = basep;
+
+      _RelocateChain (*chain++, &data_start);
+      for (basep = &__text__; basep < baselim; basep++, chain++)
+	if (*chain >= 0)
+	  {
+	    if (*basep == NULL)
+	      _GccLockCodeSection (basep);
+	    _RelocateChain (*chain, *basep);
+	  }
+
+      MemHandleUnlock (relocH);
+      DmReleaseResource (relocH);
+    }
+}
+
 #endif
 #ifdef Lmulti_free
 
@@ -90,6 +166,39 @@ _GccReleaseCode (UInt16 cmd UNUSED_PARAM, void *pbp UNUSED_PARAM, UInt16 flags)
     }
 }
 
+#endif
+#ifdef Llazy_free
+
+extern void *__text__;
+extern MemHandle _GccCodeHandles[];
+
+void
+_GccLazyReleaseCode (UInt16 cmd UNUSED_PARAM, void *pbp UNUSED_PARAM,
+		     UInt16 flags)
+{
+  if (flags & sysAppLaunchFlagNewGlobals)
+    {
+      void **basep = &__text__;
+      UInt16 i;
+
+      for (i = 1; i < _GccCodeCount; i++)
+	{
+	  if (basep[i])
+	    MemHandleUnlock (_GccCodeHandles[i]);
+	  DmReleaseResource (_GccCodeHandles[i]);
+	}
+    }
+}
+
+#endif
+#ifdef Lcode_bases
+
+/* Defined here, rather than by multi_dreloc and lazy_dreloc, so that the
+   debugger stub can refer to them in single code resource programs too.
+   There they are left zero.  */
+void **_GccCodeBases = NULL;
+UInt16 _GccCodeCount = 0;
+
 #endif
 #ifdef Lreloc_chain
 
@@ -18,6 +18,12 @@
 
 #include "crt.h"
 
+/* Report the program's whereabouts to the debugger: the text offset in D0,
+   the addresses of bss_start and data_start in D1 and D2, and PilotMain
+   in A0, with 0x12BEEF34 in D3.  Debuggers that understand it also get the
+   table of code resource bases in A1 and its length in D5, flagged by
+   0x12BEEF35 in D4.  */
+
 static void
 StartDebug (UInt16 cmd UNUSED_PARAM, void *pbp UNUSED_PARAM, UInt16 flags)
 {
@@ -35,14 +41,19 @@ StartDebug (UInt16 cmd UNUSED_PARAM, void *pbp UNUSED_PARAM, UInt16 flags)
        move.l %%a1,%%d2
        lea %1,%%a1
        move.l %%a1,%%d1
+       move.l %2,%%a1
+       moveq #0,%%d5
+       move.w %3,%%d5
+       move.l #0x12BEEF35, %%d4
        lea start(%%pc),%%a0
        move.l %%a0,%%d0
        sub.l #start, %%d0
        lea PilotMain(%%pc),%%a0
        move.l #0x12BEEF34, %%d3
        trap #8
-       " : : "g" (data_start), "g" (bss_start)
-         : "d0", "d1", "d2", "d3", "a1", "a0");
+       " : : "g" (data_start), "g" (bss_start),
+             "g" (_GccCodeBases), "g" (_GccCodeCount)
+         : "d0", "d1", "d2", "d3", "d4", "d5", "a1", "a0");
 }
 
-static void *hook __attribute__ ((section ("bhook"), unused)) = StartDebug;
+static void *hook __attribute__ ((section ("gbhook"), unused)) = StartDebug;
@@ -21,15 +21,24 @@
 
 extern UInt32 start ();
 
+/* Hooks that need globals go in the gbhook and gehook sections, which the
+   linker script puts on the inside of the bhook and ehook tables: between
+   bhook_globals and bhook_end, and between ehook_start and ehook_globals.
+   They are run only when GLOBALS is non-zero, so launches without globals
+   usually have no hooks to run at all.  */
+
 void
-__do_bhook (UInt16 cmd, void *PBP, UInt16 flags)
+__do_bhook (UInt16 cmd, void *PBP, UInt16 flags, int globals)
 {
     void **hookend, **hookptr;
     unsigned long text = (unsigned long)&start;
     asm ("sub.l #start, %0" : "=g" (text) : "0" (text));
 
     asm ("lea bhook_start,%0; add.l %1,%0" : "=a" (hookptr) : "g" (text));
-    asm ("lea bhook_end,%0; add.l %1,%0" : "=a" (hookend) : "g" (text));
+    if (globals)
+	asm ("lea bhook_end,%0; add.l %1,%0" : "=a" (hookend) : "g" (text));
+    else
+	asm ("lea bhook_globals,%0; add.l %1,%0" : "=a" (hookend) : "g" (text));
 
     while (hookptr < hookend) {
 	void (*fptr)(UInt16,void*,UInt16) = (*(hookptr++)) + text;
@@ -38,13 +47,16 @@ __do_bhook (UInt16 cmd, void *PBP, UInt16 flags)
 }
 
 void
-__do_ehook (UInt16 cmd, void *PBP, UInt16 flags)
+__do_ehook (UInt16 cmd, void *PBP, UInt16 flags, int globals)
 {
     void **hookstart, **hookptr;
     unsigned long text = (unsigned long)&start;
     asm ("sub.l #start, %0" : "=g" (text) : "0" (text));
 
-    asm ("lea ehook_start,%0; add.l %1,%0" : "=a" (hookstart) : "g" (text));
+    if (globals)
+	asm ("lea ehook_start,%0; add.l %1,%0" : "=a" (hookstart) : "g" (text));
+    else
+	asm ("lea ehook_globals,%0; add.l %1,%0" : "=a" (hookstart) : "g" (text));
     asm ("lea ehook_end,%0; add.l %1,%0" : "=a" (hookptr) : "g" (text));
 
     while (hookptr > hookstart) {
@@ -148,7 +148,7 @@ UInt32 start(UInt16 ref, struct LibRef *libref,
     _GccRelocateData();
     __do_ctors();
     AllocSaveTable();
-    __do_bhook(0, NULL, 0);
+    __do_bhook(0, NULL, 0, 1);
     reg_a4 = save_a4;
     return 0;
 }
@@ -165,7 +165,7 @@ static void clean(UInt16 dummy UNUSED_PARAM, struct LibRef *libref)
     reg_a4 = libref->globals;
     MemHandleUnlock(savetableHand);
     MemHandleFree(savetableHand);
-    __do_ehook(0, NULL, 0);
+    __do_ehook(0, NULL, 0, 1);
     __do_dtors();
     reg_a4 = save_a4;
 #ifdef USE_DYNAMIC_MEM_ONLY
@@ -44,14 +44,15 @@ int toupper (int _c);
    into the headlights of namespace collision.  */
 
 #if __GNUC__ >= 3 || defined _NEED_HONEST_CTYPE_DECLS
-extern const unsigned char _Ctype[], _Cconv[];
+extern const unsigned char _Ctype[], _Cconv[], _Cdigit[];
 #else
 /* Work around the "extern const data still goes in .data" bug in prc-tools
    m68k GCC.  FIXME When m68k-palmos-gcc is based on GCC 3.x and thus the bug
    is fixed, this (and the _NEED_HONEST_CTYPE_DECLS hack) can be removed.  */
-extern void _Ctype (), _Cconv ();
+extern void _Ctype (), _Cconv (), _Cdigit ();
 #define _Ctype  ((const unsigned char *) _Ctype)
 #define _Cconv  ((const unsigned char *) _Cconv)
+#define _Cdigit ((const unsigned char *) _Cdigit)
 #endif
 
 #define isalnum(c)  (_Ctype[(int) (c)] & 0x1c)
@@ -0,0 +1,227 @@
+/* armletbench.c: the same armlet compiled as ARM code and as Thumb code,
+   to compare their sizes and cycle counts.
+
+   This is a bare program for the simulator, like strbencharm.c.  Its
+   _start code plays the part of PceNativeCall, calling the armlet's start
+   function in ARM state with a pointer to big-endian 68K data; when the
+   armlet is Thumb code, that call goes through the linker's ARM-to-Thumb
+   veneer.  The armlet itself uses no global data, so it would run
+   unchanged as a real armlet.
+
+   The armletbench target in Makefile.in builds armletbench-arm and
+   armletbench-thumb, and prints their sizes.  Each prints a checksum,
+   which should be the same for both, and the simulator's -v option shows
+   the total cycles:
+
+	arm-palmos-run -v --profile armletbench-arm
+	arm-palmos-run -v --profile armletbench-thumb
+
+   Add --profile-wait=N,S to charge wait states for slower memory, or use
+   arm-palmos-gprof on the gmon.out written to see where the time goes.
+
+   This code is in the public domain.  */
+
+#include <string.h>
+#include <stdlib.h>
+
+#define NSAMPLES  256
+#define NKEYS	  64
+#define NPASSES	  20
+
+/* The 68K side's parameter block, as the armlet sees it: every field is
+   big-endian.  */
+struct params {
+  unsigned char nsamples[2];
+  unsigned char nkeys[2];
+  unsigned char samples[4];	/* Pointer to NSAMPLES big-endian words.  */
+  unsigned char keys[4];	/* Pointer to NKEYS big-endian longs.  */
+  unsigned char text[4];	/* Pointer to a string of numbers.  */
+  };
+
+static unsigned int
+get16 (const unsigned char *p) {
+  return (p[0] << 8) | p[1];
+  }
+
+static unsigned long
+get32 (const unsigned char *p) {
+  return ((unsigned long) p[0] << 24) | ((unsigned long) p[1] << 16)
+	 | (p[2] << 8) | p[3];
+  }
+
+static void
+put16 (unsigned char *p, unsigned int v) {
+  p[0] = v >> 8, p[1] = v;
+  }
+
+/* Smooth the samples with a small fixed-point filter, in place, and
+   return the range of the result.  */
+static long
+filter (unsigned char *samples, int n) {
+  long prev2 = 0, prev = 0, lo = 32767, hi = -32768;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    long x = (short) get16 (&samples[2 * i]);
+    long y = (x * 5 + prev * 2 + prev2) >> 3;
+    prev2 = prev, prev = x;
+    if (y < lo)  lo = y;
+    if (y > hi)  hi = y;
+    put16 (&samples[2 * i], y);
+    }
+
+  return hi - lo;
+  }
+
+static void
+sort (unsigned long *keys, int n) {
+  int i, j;
+
+  for (i = 1; i < n; i++) {
+    unsigned long k = keys[i];
+    for (j = i; j > 0 && keys[j - 1] > k; j--)
+      keys[j] = keys[j - 1];
+    keys[j] = k;
+    }
+  }
+
+static unsigned int
+crc16 (const unsigned char *p, int n) {
+  unsigned int crc = 0xffff;
+  int i;
+
+  while (n-- > 0) {
+    crc ^= *p++ << 8;
+    for (i = 0; i < 8; i++)
+      crc = (crc & 0x8000)? ((crc << 1) ^ 0x1021) & 0xffff : crc << 1;
+    }
+
+  return crc;
+  }
+
+/* Sum the numbers in TEXT, and rewrite it with each number negated.  */
+static long
+rewrite (char *text, char *buf) {
+  const char *s = text;
+  char *end, *d = buf;
+  long sum = 0;
+
+  for (;;) {
+    long v = strtol (s, &end, 10);
+    char digits[12], *q = &digits[sizeof digits];
+    unsigned long u;
+
+    if (end == s)
+      break;
+
+    sum += v;
+    u = (v < 0)? -v : v;
+    *--q = '\0';
+    do *--q = '0' + u % 10;  while ((u /= 10) != 0);
+    if (v > 0)
+      *--q = '-';
+
+    memcpy (d, q, strlen (q));
+    d += strlen (q);
+    *d++ = ' ';
+    s = end;
+    }
+
+  *d = '\0';
+  strcpy (text, buf);
+  return sum;
+  }
+
+unsigned long
+start (const void *emulStateP, void *userData68KP, void *call68KFuncP) {
+  const struct params *p = userData68KP;
+  int nsamples = get16 (p->nsamples), nkeys = get16 (p->nkeys);
+  unsigned char *samples = (unsigned char *) get32 (p->samples);
+  const unsigned char *keys68k = (const unsigned char *) get32 (p->keys);
+  char *text = (char *) get32 (p->text);
+  unsigned long keys[NKEYS], sum = 0;
+  char buf[256];
+  int pass, i;
+
+  for (pass = 0; pass < NPASSES; pass++) {
+    for (i = 0; i < nkeys; i++)
+      keys[i] = get32 (&keys68k[4 * i]) ^ (pass * 0x9e3779b9UL);
+    sort (keys, nkeys);
+
+    sum = sum * 31 + filter (samples, nsamples);
+    sum = sum * 31 + crc16 (samples, 2 * nsamples);
+    sum = sum * 31 + keys[nkeys / 2];
+    sum = sum * 31 + rewrite (text, buf);
+    }
+
+  return sum;
+  }
+
+
+/* The rest stands in for the 68K application and Palm OS.  The _start
+   code, which is ARM code as the real PceNativeCall is, calls the armlet
+   with the parameter block that setup returns, and report prints the
+   armlet's result.  */
+
+asm ("	.text\n"
+     "	.arm\n"
+     "	.global _start\n"
+     "	.type _start, %function\n"
+     "_start:\n"
+     "	ldr sp, =0x200000\n"
+     "	bl setup\n"
+     "	mov r1, r0\n"
+     "	mov r0, #0\n"
+     "	mov r2, #0\n"
+     "	bl start\n"
+     "	bl report\n"
+     "	mov r0, #0\n"
+     "	swi 0x11\n");		/* SWI_Exit */
+
+static void
+console (const char *text) {
+  asm volatile ("mov r0, %0; swi 0x2" : : "r" (text) : "r0");  /* SWI_Write0 */
+  }
+
+static void
+put32 (unsigned char *p, unsigned long v) {
+  p[0] = v >> 24, p[1] = v >> 16, p[2] = v >> 8, p[3] = v;
+  }
+
+static unsigned char samples[2 * NSAMPLES], keys[4 * NKEYS];
+static char text[256] = "12 -7 300 4096 -65 8 77 1000 -3 42 9 -12000 5";
+static struct params params;
+
+struct params *
+setup (void) {
+  unsigned long seed = 1;
+  int i;
+
+  for (i = 0; i < NSAMPLES; i++) {
+    seed = seed * 1103515245 + 12345;
+    put16 (&samples[2 * i], (seed >> 16) & 0x3fff);
+    }
+
+  for (i = 0; i < NKEYS; i++) {
+    seed = seed * 1103515245 + 12345;
+    put32 (&keys[4 * i], seed);
+    }
+
+  put16 (params.nsamples, NSAMPLES);
+  put16 (params.nkeys, NKEYS);
+  put32 (params.samples, (unsigned long) samples);
+  put32 (params.keys, (unsigned long) keys);
+  put32 (params.text, (unsigned long) text);
+  return &params;
+  }
+
+void
+report (unsigned long sum) {
+  char hex[10];
+  int i;
+
+  for (i = 0; i < 8; i++)
+    hex[i] = "0123456789abcdef"[(sum >> (28 - 4 * i)) & 15];
+  hex[8] = '\n', hex[9] = '\0';
+  console (hex);
+  }
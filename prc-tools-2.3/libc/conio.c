@@ -6,6 +6,7 @@
  */
 
 #include "stdio.h"
+#include "string.h"
 
 #ifdef BOOTSTRAP
 #include "bootstrap.h"
@@ -32,53 +33,130 @@
 #define XMAX 32
 #define YMAX 14
 
+/* Width of the console area; text is clipped at the edge of the screen.  */
+#define XEXT (160 - XB)
+
 static char fb[XMAX * YMAX];
+static unsigned char len[YMAX];	/* Characters in each line of fb.  */
 
 static int xc;
 static int yc;
 
-static inline int DRAWLN(int LN) 
+/* Drawing is deferred: DIRTY has a bit set for each line changed since it
+   was last drawn, and SCROLLED counts the lines the text has moved up by
+   since the screen was last scrolled.  A redraw then costs one scroll and
+   a WinDrawChars per changed line, however many newlines came between.  */
+static unsigned long dirty;
+static int scrolled;
+
+/* Lines to output between redraws, or 0 to redraw after every line.  */
+static unsigned int defer;
+static unsigned int lines;
+
+static void redraw()
 {
-  FntSetFont(stdFont);
-  WinDrawChars(&fb[LN * XMAX], StrLen(&fb[LN * XMAX]), XB, YB + YINC*(LN));
-  return 0;
+  RectangleType area = { { XB, YB }, { XEXT, YMAX * YINC } };
+  int i;
+
+  if (scrolled >= YMAX) {
+    WinEraseRectangle(&area, 0);
+  }
+  else if (scrolled > 0) {
+    RectangleType vacated;
+    WinScrollRectangle(&area, winUp, scrolled * YINC, &vacated);
+    WinEraseRectangle(&vacated, 0);
+  }
+  scrolled = 0;
+
+  if (dirty) {
+    FntSetFont(stdFont);
+    for (i=0;i<YMAX;i++)
+      if (dirty & (1UL << i))
+	WinDrawChars(&fb[i * XMAX], len[i], XB, YB + YINC*i);
+    dirty = 0;
+  }
+
+  lines = 0;
 }
 
-static int scroll()
+/* Scroll the text, but not yet the screen, up by a line.  */
+static void scroll()
 {
-  int i;
-  RectangleType r = { { XB, YB }, { XB + XMAX * 4, YB + (YMAX -1) * YINC } };
-  RectangleType v = { { XB, YB + (YMAX-2)*YINC }, { XB + XMAX * 4, YB + (YMAX -1) * YINC } };
+  memmove(fb, &fb[XMAX], (YMAX-1) * XMAX);
+  memmove(len, &len[1], YMAX-1);
+  len[YMAX-1] = 0;
+  dirty >>= 1;
+  if (scrolled < YMAX) scrolled++;
+  yc = YMAX-1;
+}
 
-  WinScrollRectangle(&r, winUp, YINC, &v);
-  for (i=0;i<XMAX;) fb[(YMAX-1) * XMAX + i++]=0;
-  WinEraseRectangle(&v,1);
+static void newline()
+{
+  yc++;
+  xc = 0;
+  if (defer == 0 || ++lines >= defer) redraw();
+}
 
-  return YMAX-1;
+void _Condefer (unsigned int n)
+{
+  defer = n;
+  redraw();
+}
+
+int fflush (FILE *stream)
+{
+  if (stream == NULL || stream == stdout || stream == stderr) redraw();
+  return 0;
 }
 
 int putchar (unsigned int buf)
 {
   if (buf == '\n' || (!(xc < XMAX))) {
-    DRAWLN(yc++);
-    xc = 0;
-
+    newline();
     if (buf =='\n') return 0;
   }
 
-  if (!(yc < YMAX)) yc = scroll();
+  if (!(yc < YMAX)) scroll();
 
   fb[yc * XMAX + xc++] = buf;
+  len[yc] = xc;
+  dirty |= 1UL << yc;
   return 0;
 }
 
-int puts (unsigned char *string)
+/* The same as calling putchar for each character, but copying each run
+   up to the end of a line or a newline into the buffer in one go.  */
+void _Conwrite (const char *s, size_t n)
 {
-  int i;
-
-  for (i=0;i<StrLen(string);i++) {
-    putchar(string[i]);
+  while (n > 0) {
+    const char *nl;
+    size_t run;
+
+    if (*s == '\n' || !(xc < XMAX)) {
+      putchar(*s++);
+      n--;
+      continue;
+    }
+
+    if (!(yc < YMAX)) scroll();
+
+    run = XMAX - xc;
+    if (run > n) run = n;
+    nl = memchr(s, '\n', run);
+    if (nl) run = nl - s;
+
+    memcpy(&fb[yc * XMAX + xc], s, run);
+    xc += run;
+    len[yc] = xc;
+    dirty |= 1UL << yc;
+    s += run;
+    n -= run;
   }
+}
+
+int puts (unsigned char *string)
+{
+  _Conwrite((const char *) string, StrLen((const char *) string));
   putchar('\n');
   return 0;
 }
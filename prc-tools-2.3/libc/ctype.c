@@ -148,6 +148,24 @@ const unsigned char _Cconv[] = { OFFSETS, 0,0,0,0, 0,0,0,0, LATIN1 (0) };
 const unsigned char _Ctype[] = { ASCII, LATIN1 (FF) };
 #endif
 
+/* _Cdigit[] gives the value of each (unsigned char) character as a digit
+   in bases up to 36, or 36 if it is not a digit in any base, so that the
+   strto* functions can decode a digit and check it against the base with
+   a single lookup.  */
+
+#define X 36
+#define X16  X,X,X,X, X,X,X,X, X,X,X,X, X,X,X,X
+#define LETTERS \
+  10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35
+
+const unsigned char _Cdigit[] = {
+/* 00-2f */	X16, X16, X16,
+/* 0 - ? */	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, X, X, X, X, X, X,
+/* @ - _ */	X, LETTERS, X, X, X, X, X,
+/* ` -7f */	X, LETTERS, X, X, X, X, X,
+/* 80-ff */	X16, X16, X16, X16, X16, X16, X16, X16
+  };
+
 #endif
 #ifdef Lisalnum
 int (isalnum) (int c) { return isalnum (c); }
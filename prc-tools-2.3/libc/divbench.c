@@ -0,0 +1,221 @@
+/* divbench.c: cycle counts for the integer division routines in libgcc
+   (__udivsi3, __divsi3, __umodsi3, __modsi3, and the 64 bit ones built on
+   __udiv_qrnnd) and for ldiv and lldiv from division.c.
+
+   This is a Palm OS application, built by the divbench.prc target in
+   Makefile.in.  Run it on a device or the Emulator; for each class of
+   operands it displays the average cycles per operation, including the
+   call overhead.  The processor clock is measured as in strbench.c.  To
+   compare versions of libgcc, build it against each of them.
+
+   This code is in the public domain.  */
+
+#include <SystemMgr.h>
+#include <TimeMgr.h>
+#include <Window.h>
+#include <StringMgr.h>
+
+#include <NewTypes.h>
+
+#include <stdlib.h>
+
+static void
+console (const char *text) {
+  static Int16 y = 0;
+  WinDrawChars (text, StrLen (text), 0, y);
+  y += 10;
+  }
+
+/* Each iteration of the dbra loop takes 10 cycles, and there are 65536
+   of them per call.  */
+static void
+spin (void) {
+  UInt16 n = 0xffff;
+  asm volatile ("1: dbra %0,1b" : "+d" (n));
+  }
+
+static UInt32 cycles_per_tick;
+
+static void
+calibrate (void) {
+  UInt32 start, ticks, n = 0;
+
+  start = TimGetTicks ();
+  do {
+    spin ();
+    n++;
+    ticks = TimGetTicks () - start;
+    } while (ticks < 2 * SysTicksPerSecond ());
+
+  cycles_per_tick = n * 655360UL / ticks;
+  }
+
+#define NOPERANDS  64
+
+static unsigned long numer[NOPERANDS], denom[NOPERANDS];
+static unsigned long long lnumer[NOPERANDS], ldenom[NOPERANDS];
+
+/* Results are stored here so that the operations aren't optimized away.  */
+static volatile unsigned long sink;
+static volatile unsigned long long lsink;
+
+static unsigned long seed = 1;
+
+static unsigned long
+random32 (void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+  }
+
+/* Operands for each class: a 16 bit dividend and 8 bit divisor, 32 by 16
+   bits, 32 by at least 17 bits, 64 by 32 bits, and 64 by 64 bits.  Signed
+   operations see negative operands about half the time.  */
+
+enum { SMALL, BY16, BY32, LONG_BY32, LONG_BY64 };
+
+static const char *const class_name[] = {
+  "16/8", "32/16", "32/32", "64/32", "64/64"
+  };
+
+static void
+generate (int cls) {
+  int i;
+
+  for (i = 0; i < NOPERANDS; i++) {
+    unsigned long n = random32 (), d = random32 ();
+
+    switch (cls) {
+    case SMALL:  n = (long) (short) n;  d = (long) (signed char) d;  break;
+    case BY16:   d = (long) (short) d;  break;
+    case BY32:   d = (d | 0x10000UL) >> (random32 () & 15);  break;
+      }
+    if (d == 0)  d = 1;
+
+    numer[i] = n;
+    denom[i] = d;
+    lnumer[i] = (long long) (long) n;
+    ldenom[i] = (long long) (long) d;
+    if (cls >= LONG_BY32)
+      lnumer[i] = (unsigned long long) random32 () << 32 | n;
+    if (cls == LONG_BY64)
+      ldenom[i] = (unsigned long long) (random32 () >> (random32 () & 15))
+		  << 32 | d;
+    }
+  }
+
+enum { UDIV, UMOD, SDIV, SMOD, DIVMOD, LDIV, LLDIVMOD, LLDIV, NOPS };
+
+static const char *const op_name[] = {
+  "u/", "u%", "/", "%", "/%", "ldiv", "ll/%", "lldiv"
+  };
+
+static void
+operate (int op) {
+  int i;
+
+  switch (op) {
+  case UDIV:
+    for (i = 0; i < NOPERANDS; i++)  sink = numer[i] / denom[i];
+    break;
+  case UMOD:
+    for (i = 0; i < NOPERANDS; i++)  sink = numer[i] % denom[i];
+    break;
+  case SDIV:
+    for (i = 0; i < NOPERANDS; i++)
+      sink = (long) numer[i] / (long) denom[i];
+    break;
+  case SMOD:
+    for (i = 0; i < NOPERANDS; i++)
+      sink = (long) numer[i] % (long) denom[i];
+    break;
+  case DIVMOD:
+    for (i = 0; i < NOPERANDS; i++) {
+      sink = (long) numer[i] / (long) denom[i];
+      sink = (long) numer[i] % (long) denom[i];
+      }
+    break;
+  case LDIV:
+    for (i = 0; i < NOPERANDS; i++) {
+      ldiv_t res = ldiv (numer[i], denom[i]);
+      sink = res.quot;
+      sink = res.rem;
+      }
+    break;
+  case LLDIVMOD:
+    for (i = 0; i < NOPERANDS; i++) {
+      lsink = (long long) lnumer[i] / (long long) ldenom[i];
+      lsink = (long long) lnumer[i] % (long long) ldenom[i];
+      }
+    break;
+  case LLDIV:
+    for (i = 0; i < NOPERANDS; i++) {
+      lldiv_t res = lldiv (lnumer[i], ldenom[i]);
+      lsink = res.quot;
+      lsink = res.rem;
+      }
+    break;
+    }
+  }
+
+/* Average cycles per operation, including the loop overhead.  */
+static UInt32
+measure (int op) {
+  UInt32 start, ticks, calls = 0;
+
+  start = TimGetTicks ();
+  do {
+    operate (op);
+    calls += NOPERANDS;
+    ticks = TimGetTicks () - start;
+    } while (ticks < SysTicksPerSecond () / 2);
+
+  return ticks * cycles_per_tick / calls;
+  }
+
+static void
+bench (int cls) {
+  char line[80];
+  int op;
+
+  generate (cls);
+
+  /* The 32 bit operations aren't interesting for 64 bit operands.  */
+  StrPrintF (line, "%s:", class_name[cls]);
+  for (op = UDIV; op < NOPS; op++) {
+    char *p = line + StrLen (line);
+    if (cls >= LONG_BY32 && op < LLDIVMOD)
+      StrCopy (p, " -");
+    else
+      StrPrintF (p, " %lu", measure (op));
+    }
+  console (line);
+  }
+
+UInt32
+PilotMain (UInt16 cmd, void *cmdPBP __attribute__ ((unused)),
+	   UInt16 launchFlags __attribute__ ((unused))) {
+  if (cmd == sysAppLaunchCmdNormalLaunch) {
+    char line[80];
+    int cls, op;
+
+    calibrate ();
+    StrPrintF (line, "%lu cycles/tick", cycles_per_tick);
+    console (line);
+
+    StrCopy (line, "Columns:");
+    for (op = UDIV; op < NOPS; op++) {
+      char *p = line + StrLen (line);
+      StrPrintF (p, " %s", op_name[op]);
+      }
+    console (line);
+
+    for (cls = SMALL; cls <= LONG_BY64; cls++)
+      bench (cls);
+
+    SysTaskDelay (30 * SysTicksPerSecond ());
+    }
+
+  return 0;
+  }
@@ -4,13 +4,35 @@
 
 #include "stdlib.h"
 
+#if defined (__m68k__) && defined (__palmos__)
+/* In the m68k-palmos libgcc, __divsi3 leaves the remainder in d1 as well
+   as returning the quotient in d0, so one call provides both.  Otherwise
+   GCC would call __divsi3 and then __modsi3 with the same operands.  */
+#define divsi3(quot, rem, numer, denom)					\
+  do {									\
+    register long int q_ asm ("d0");					\
+    register long int r_ asm ("d1");					\
+    asm ("move%.l %3,%-\n\tmove%.l %2,%-\n\t"				\
+	 "bsr%.w __divsi3\n\taddq%.l %#8,%/sp"				\
+	 : "=r" (q_), "=r" (r_)						\
+	 : "r" ((long int) (numer)), "r" ((long int) (denom))		\
+	 : "d2", "a0", "a1");						\
+    (quot) = q_, (rem) = r_;						\
+    } while (0)
+#endif
+
 #ifdef Ldiv
 
 div_t
 div (int numer, int denom) {
   div_t res;
+#if defined (divsi3) && __INT_MAX__ > 32767
+  divsi3 (res.quot, res.rem, numer, denom);
+#else
+  /* With 16 bit ints, GCC gets both from a single divs instruction.  */
   res.quot = numer / denom;
   res.rem = numer % denom;
+#endif
   return res;
   }
 
@@ -20,8 +42,12 @@ div (int numer, int denom) {
 ldiv_t
 ldiv (long int numer, long int denom) {
   ldiv_t res;
+#ifdef divsi3
+  divsi3 (res.quot, res.rem, numer, denom);
+#else
   res.quot = numer / denom;
   res.rem = numer % denom;
+#endif
   return res;
   }
 
@@ -31,8 +57,26 @@ ldiv (long int numer, long int denom) {
 lldiv_t
 lldiv (long long int numer, long long int denom) {
   lldiv_t res;
-  res.quot = numer / denom;
-  res.rem = numer % denom;
+
+  /* Operands that fit in a long are divided as such, which is much
+     quicker.  (LONG_MIN / -1 overflows a long, though not a long long.)  */
+  if (numer == (long int) numer && denom == (long int) denom && denom != -1) {
+    ldiv_t lres;
+#ifdef divsi3
+    divsi3 (lres.quot, lres.rem, numer, denom);
+#else
+    lres.quot = (long int) numer / (long int) denom;
+    lres.rem = (long int) numer % (long int) denom;
+#endif
+    res.quot = lres.quot;
+    res.rem = lres.rem;
+    }
+  else {
+    /* Multiplying back is much cheaper than a second long long division.  */
+    res.quot = numer / denom;
+    res.rem = numer - res.quot * denom;
+    }
+
   return res;
   }
 
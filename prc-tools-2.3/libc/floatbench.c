@@ -0,0 +1,179 @@
+/* floatbench.c: cycle counts for libgcc's single precision arithmetic,
+   both the default routines and the __fast_* ones used with -mfast-float,
+   and for the corresponding New Float Manager traps, which -lnfm uses.
+
+   This is a Palm OS application, built by the floatbench.prc target in
+   Makefile.in.  Run it on a device or the Emulator; for each operation it
+   displays the average cycles per call of the three versions, including
+   the call overhead.  The processor clock is measured as in divbench.c.
+   floattst.c checks the results of the libgcc routines.
+
+   This code is in the public domain.  */
+
+#include <SystemMgr.h>
+#include <TimeMgr.h>
+#include <Window.h>
+#include <StringMgr.h>
+
+#include <NewTypes.h>
+
+static void
+console (const char *text) {
+  static Int16 y = 0;
+  WinDrawChars (text, StrLen (text), 0, y);
+  y += 10;
+  }
+
+/* Each iteration of the dbra loop takes 10 cycles, and there are 65536
+   of them per call.  */
+static void
+spin (void) {
+  UInt16 n = 0xffff;
+  asm volatile ("1: dbra %0,1b" : "+d" (n));
+  }
+
+static UInt32 cycles_per_tick;
+
+static void
+calibrate (void) {
+  UInt32 start, ticks, n = 0;
+
+  start = TimGetTicks ();
+  do {
+    spin ();
+    n++;
+    ticks = TimGetTicks () - start;
+    } while (ticks < 2 * SysTicksPerSecond ());
+
+  cycles_per_tick = n * 655360UL / ticks;
+  }
+
+/* The routines are called by name, so that all three versions can be
+   linked into one program.  */
+
+float __addsf3 (float, float);
+float __subsf3 (float, float);
+float __mulsf3 (float, float);
+float __divsf3 (float, float);
+int __ltsf2 (float, float);
+
+float __fast_addsf3 (float, float);
+float __fast_subsf3 (float, float);
+float __fast_mulsf3 (float, float);
+float __fast_divsf3 (float, float);
+int __fast_ltsf2 (float, float);
+
+/* The New Float Manager traps, as declared in crt/nfm.c.  */
+#define NFM(sel) \
+  __attribute__ ((callseq ("moveq #" #sel ",%%d2; trap #15; dc.w 0xA306")))
+
+float nfm_add (float, float)	NFM (46);
+float nfm_sub (float, float)	NFM (48);
+float nfm_mul (float, float)	NFM (47);
+float nfm_div (float, float)	NFM (49);
+int nfm_flt (float, float)	NFM (29);
+
+#define NOPERANDS  64
+
+static float x[NOPERANDS], y[NOPERANDS];
+
+/* Results are stored here so that the operations aren't optimized away.  */
+static volatile float sink;
+static volatile int isink;
+
+static unsigned long seed = 1;
+
+static unsigned long
+random32 (void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+  }
+
+/* Normalized operands of either sign, between 2^-28 and 2^28.  */
+static void
+generate (void) {
+  union { float f; unsigned long u; } v;
+  int i;
+
+  for (i = 0; i < NOPERANDS; i++) {
+    v.u = random32 ();
+    v.u = (v.u & 0x807fffffUL) | (v.u % 56 + 99) << 23;
+    x[i] = v.f;
+    v.u = random32 ();
+    v.u = (v.u & 0x807fffffUL) | (v.u % 56 + 99) << 23;
+    y[i] = v.f;
+    }
+  }
+
+enum { ADD, SUB, MUL, DIV, LT, NOPS };
+enum { LIBGCC, FAST, TRAP };
+
+static const char *const op_name[] = { "add", "sub", "mul", "div", "lt" };
+
+static void
+operate (int op, int version) {
+  int i;
+
+  for (i = 0; i < NOPERANDS; i++)
+    switch (version * NOPS + op) {
+    case LIBGCC * NOPS + ADD:  sink = __addsf3 (x[i], y[i]);  break;
+    case LIBGCC * NOPS + SUB:  sink = __subsf3 (x[i], y[i]);  break;
+    case LIBGCC * NOPS + MUL:  sink = __mulsf3 (x[i], y[i]);  break;
+    case LIBGCC * NOPS + DIV:  sink = __divsf3 (x[i], y[i]);  break;
+    case LIBGCC * NOPS + LT:   isink = __ltsf2 (x[i], y[i]);  break;
+    case FAST * NOPS + ADD:    sink = __fast_addsf3 (x[i], y[i]);  break;
+    case FAST * NOPS + SUB:    sink = __fast_subsf3 (x[i], y[i]);  break;
+    case FAST * NOPS + MUL:    sink = __fast_mulsf3 (x[i], y[i]);  break;
+    case FAST * NOPS + DIV:    sink = __fast_divsf3 (x[i], y[i]);  break;
+    case FAST * NOPS + LT:     isink = __fast_ltsf2 (x[i], y[i]);  break;
+    case TRAP * NOPS + ADD:    sink = nfm_add (x[i], y[i]);  break;
+    case TRAP * NOPS + SUB:    sink = nfm_sub (x[i], y[i]);  break;
+    case TRAP * NOPS + MUL:    sink = nfm_mul (x[i], y[i]);  break;
+    case TRAP * NOPS + DIV:    sink = nfm_div (x[i], y[i]);  break;
+    case TRAP * NOPS + LT:     isink = nfm_flt (x[i], y[i]);  break;
+      }
+  }
+
+/* Average cycles per operation, including the loop overhead.  */
+static UInt32
+measure (int op, int version) {
+  UInt32 start, ticks, calls = 0;
+
+  start = TimGetTicks ();
+  do {
+    operate (op, version);
+    calls += NOPERANDS;
+    ticks = TimGetTicks () - start;
+    } while (ticks < SysTicksPerSecond () / 2);
+
+  return ticks * cycles_per_tick / calls;
+  }
+
+UInt32
+PilotMain (UInt16 cmd, void *cmdPBP __attribute__ ((unused)),
+	   UInt16 launchFlags __attribute__ ((unused))) {
+  if (cmd == sysAppLaunchCmdNormalLaunch) {
+    char line[80];
+    int op;
+
+    calibrate ();
+    StrPrintF (line, "%lu cycles/tick", cycles_per_tick);
+    console (line);
+    console ("Columns: libgcc fast NFM");
+
+    generate ();
+    for (op = ADD; op < NOPS; op++) {
+      UInt32 libgcc = measure (op, LIBGCC);
+      UInt32 fast = measure (op, FAST);
+      UInt32 trap = measure (op, TRAP);
+      StrPrintF (line, "%s: %lu %lu %lu", op_name[op], libgcc, fast, trap);
+      console (line);
+      }
+
+    SysTaskDelay (30 * SysTicksPerSecond ());
+    }
+
+  return 0;
+  }
@@ -0,0 +1,254 @@
+/* floattst.c: checks libgcc's single precision arithmetic against the
+   host's IEEE arithmetic.
+
+   The same operand pairs are generated on both sides: random bit patterns,
+   special values (zeros, denormals, infinities, NaNs and the extremes),
+   nearly equal values, whose difference cancels, and operands whose
+   results overflow or underflow.  Each is added, subtracted, multiplied,
+   divided, negated and compared, and the results of each operation are
+   summed up, block by block, as CRCs.
+
+   Built and run on the host, by the floattst.h target in Makefile.in,
+   this writes the CRCs of the correct results to floattst.h.  Built with
+   that as a Palm OS application, by the floattst.prc target, it finds
+   the same CRCs with libgcc's routines and lists the blocks and
+   operations that differ.  That target uses -mfast-float, so it checks
+   the __fast_* routines.  Build it without to check the L_float ones,
+   which get the sign of underflowed results, comparisons with NaNs and
+   some overflows wrong.  All NaNs are treated alike.
+
+   This code is in the public domain.  */
+
+#include <stdint.h>
+
+#ifdef __palmos__
+#include <SystemMgr.h>
+#include <Window.h>
+#include <StringMgr.h>
+
+#include <NewTypes.h>
+
+#include "floattst.h"
+#else
+#include <stdio.h>
+#endif
+
+#define NBLOCKS  64
+#define BLOCK    2048
+
+enum { ADD, SUB, MUL, DIV, NEG, CMP, NOPS };
+
+static uint32_t seed = 2463534242UL;
+
+static uint32_t
+random32 (void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+  }
+
+static const uint32_t special[] = {
+  0, 0x80000000UL, 1, 0x80000001UL, 2, 0x7fffffUL, 0x807fffffUL,
+  0x800000UL, 0x80800000UL, 0x800001UL, 0xffffffUL, 0x400000UL,
+  0x7f7fffffUL, 0xff7fffffUL, 0x7f000000UL, 0x7f800000UL, 0xff800000UL,
+  0x7fc00000UL, 0xffc00000UL, 0x7f800001UL, 0x3f800000UL, 0xbf800000UL,
+  0x3f800001UL, 0x3f7fffffUL, 0x3fffffffUL, 0x3effffffUL, 0x34000000UL,
+  0x33800000UL, 0x33000000UL, 0x4b000000UL, 0x4b800000UL, 0x5f000000UL,
+  0x1f800000UL
+  };
+
+#define NSPECIAL  (sizeof special / sizeof special[0])
+
+/* X with its biased exponent replaced by E.  */
+static uint32_t
+with_exponent (uint32_t x, uint32_t e) {
+  return (x & 0x807fffffUL) | (e & 0xff) << 23;
+  }
+
+/* The Ith operand pair.  Every other block, the significands are cut
+   down to a few bits, so that products and quotients are often exact or
+   exactly halfway between two floats.  */
+static void
+generate (uint32_t i, uint32_t *a, uint32_t *b) {
+  uint32_t r = random32 (), s = random32 (), t;
+
+  switch (i & 7) {
+  case 0:
+  case 1:
+    *a = r;
+    *b = s;
+    break;
+  case 2:
+    *a = special[r % NSPECIAL];
+    *b = (s & 1)? special[(s >> 8) % NSPECIAL] : s;
+    break;
+  case 3:			/* moderate exponents */
+    *a = with_exponent (r, 100 + (r >> 8) % 56);
+    *b = with_exponent (s, 100 + (s >> 8) % 56);
+    break;
+  case 4:			/* nearly equal magnitudes */
+    *a = r;
+    *b = with_exponent (r ^ (s & 0x7ff), (r >> 23) + (s >> 28) % 3 - 1)
+	 ^ (s & 0x80000000UL);
+    break;
+  case 5:			/* denormals and tiny numbers */
+    *a = with_exponent (r, (r >> 8) % 32);
+    *b = with_exponent (s, (s >> 8) % 40);
+    break;
+  case 6:			/* huge numbers */
+    *a = with_exponent (r, 200 + (r >> 8) % 56);
+    *b = with_exponent (s, 200 + (s >> 8) % 56);
+    break;
+  case 7:			/* one tiny and one huge */
+    *a = with_exponent (r, (r >> 8) % 64);
+    *b = with_exponent (s, 160 + (s >> 8) % 96);
+    break;
+    }
+
+  if (r & 0x100000UL) {
+    t = *a;
+    *a = *b;
+    *b = t;
+    }
+
+  if (i / BLOCK % 2) {
+    *a &= 0xfffc0000UL | (r >> 20);
+    *b &= 0xffffe000UL | ((s >> 7) & 0x1ff);
+    }
+  }
+
+static uint32_t crc_table[256];
+
+static void
+make_crc_table (void) {
+  uint32_t c;
+  int n, k;
+
+  for (n = 0; n < 256; n++) {
+    c = n;
+    for (k = 0; k < 8; k++)
+      c = (c & 1)? 0xedb88320UL ^ (c >> 1) : c >> 1;
+    crc_table[n] = c;
+    }
+  }
+
+static uint32_t
+crc (uint32_t c, uint32_t x) {
+  int k;
+
+  for (k = 0; k < 4; k++) {
+    c = crc_table[(c ^ x) & 0xff] ^ (c >> 8);
+    x >>= 8;
+    }
+  return c;
+  }
+
+typedef union { float f; uint32_t u; } fu;
+
+static uint32_t
+result (float x) {
+  fu v;
+
+  v.f = x;
+  if ((v.u & 0x7fffffffUL) > 0x7f800000UL)
+    v.u = 0x7fc00000UL;
+  return v.u;
+  }
+
+/* CRCs of the results for the operands in block N.  The operands are
+   volatile so that nothing is folded or evaluated in a wider format.  */
+static void
+check_block (int n, uint32_t crcs[NOPS]) {
+  volatile float x, y;
+  uint32_t i, a, b;
+  fu v;
+  int op;
+
+  for (op = ADD; op < NOPS; op++)
+    crcs[op] = 0xffffffffUL;
+
+  for (i = n * (uint32_t) BLOCK; i < (n + 1) * (uint32_t) BLOCK; i++) {
+    generate (i, &a, &b);
+    v.u = a;
+    x = v.f;
+    v.u = b;
+    y = v.f;
+
+    crcs[ADD] = crc (crcs[ADD], result (x + y));
+    crcs[SUB] = crc (crcs[SUB], result (x - y));
+    crcs[MUL] = crc (crcs[MUL], result (x * y));
+    crcs[DIV] = crc (crcs[DIV], result (x / y));
+    crcs[NEG] = crc (crcs[NEG], result (-x));
+    crcs[CMP] = crc (crcs[CMP], (x == y) | (x != y) << 1 | (x < y) << 2
+				| (x <= y) << 3 | (x > y) << 4
+				| (x >= y) << 5);
+    }
+  }
+
+#ifdef __palmos__
+
+static const char *const op_name[] = {
+  "add", "sub", "mul", "div", "neg", "cmp"
+  };
+
+static void
+console (const char *text) {
+  static Int16 y = 0;
+  WinDrawChars (text, StrLen (text), 0, y);
+  y += 10;
+  if (y >= 150)
+    y = 0;
+  }
+
+UInt32
+PilotMain (UInt16 cmd, void *cmdPBP __attribute__ ((unused)),
+	   UInt16 launchFlags __attribute__ ((unused))) {
+  if (cmd == sysAppLaunchCmdNormalLaunch) {
+    uint32_t crcs[NOPS];
+    char line[80];
+    int n, op, bad = 0;
+
+    make_crc_table ();
+    console ("Checking...");
+    for (n = 0; n < NBLOCKS; n++) {
+      check_block (n, crcs);
+      for (op = ADD; op < NOPS; op++)
+	if (crcs[op] != expected[n][op]) {
+	  StrPrintF (line, "block %d: %s differs", n, op_name[op]);
+	  console (line);
+	  bad++;
+	  }
+      }
+
+    StrPrintF (line, "%ld pairs, %d differences", (long) NBLOCKS * BLOCK, bad);
+    console (line);
+    SysTaskDelay (30 * SysTicksPerSecond ());
+    }
+
+  return 0;
+  }
+
+#else
+
+int
+main () {
+  uint32_t crcs[NOPS];
+  int n, op;
+
+  make_crc_table ();
+  printf ("/* Generated by floattst.c on the host.  */\n\n");
+  printf ("static const uint32_t expected[%d][%d] = {\n", NBLOCKS, NOPS);
+  for (n = 0; n < NBLOCKS; n++) {
+    check_block (n, crcs);
+    printf ("  {");
+    for (op = ADD; op < NOPS; op++)
+      printf (" 0x%08lxUL%s", (unsigned long) crcs[op],
+	      (op < NOPS - 1)? "," : "");
+    printf (" }%s\n", (n < NBLOCKS - 1)? "," : "");
+    }
+  printf ("  };\n");
+  return 0;
+  }
+
+#endif
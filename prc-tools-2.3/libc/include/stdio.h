@@ -3,17 +3,45 @@
 
 #include <stdarg.h>
 
-#define stdin 0
-#define stdout 1
-#define stderr 2
+#define __need_size_t
+#define __need_NULL
+#include <stddef.h>
+
+/* There are no real streams: these just identify the console.  */
+typedef struct __FILE FILE;
+
+#define stdin ((FILE *) 1)
+#define stdout ((FILE *) 2)
+#define stderr ((FILE *) 3)
 
 extern int getchar ();
 extern char *gets (char *buf);
 extern int puts (unsigned char *string);
 extern int putchar (unsigned int outch);
 
+/* Write the N characters at S to the console.  */
+extern void _Conwrite (const char *s, size_t n);
+
+/* Console output is normally drawn as each line is finished.  After
+   _Condefer (N), it is drawn only after every N lines and whenever
+   fflush (stdout) is called, say once per pass of the event loop, so that
+   printing many lines costs only one scroll and one redraw of the screen.
+   fflush (NULL) does the same.  _Condefer (0) goes back to drawing every
+   line.  */
+extern void _Condefer (unsigned int n);
+extern int fflush (FILE *stream);
+
+/* The formatting engine behind the printf family: the output is passed to
+   SINK, along with COOKIE, in runs of characters.  Returns the number of
+   characters output.  */
+extern int _Vformat(void (*sink)(void *cookie, const char *s, size_t n),
+		    void *cookie, const char *fmt, va_list args);
+
+extern int vsnprintf(char *buf, size_t size, const char *fmt, va_list args);
+extern int snprintf(char *buf, size_t size, const char *fmt, ...);
 extern int vsprintf(char *buf, const char *fmt, va_list args);
 extern int sprintf(char * buf, const char *fmt, ...);
+extern int vprintf(const char *fmt, va_list args);
 extern int printf(const char *fmt, ...);
 
 #endif /* __332_STDIO_H */
@@ -23,9 +23,68 @@
 #endif
 
 /* BOUNDARY is one more than the maximum signed value_t, expressed as an
-   unsigned value_t.  */
+   unsigned value_t.  MAXIMUM is the maximum unsigned value_t.  */
 #define BOUNDARY (((unsigned value_t) 1) << (CHAR_BIT * sizeof (value_t) - 1))
+#define MAXIMUM  ((BOUNDARY - 1) * 2 + 1)
 
+#define NEGATIVE  0x01
+#define OVERFLOW  0x02
+
+#define digit_value(c)  (_Cdigit[(unsigned char) (c)])
+
+#if defined Latol || defined Latoll || defined L_Strtoul || defined L_Strtoull
+
+/* Decimal numbers are accumulated up to nine digits at a time in an
+   unsigned long, which only needs shifts and adds, and each such chunk
+   is then combined into the full value_t with a single multiplication.
+   On the 68000 even a 32-bit multiplication is a library call, and a
+   "long long" one much more so, so this saves a great deal over doing
+   one per digit.  */
+
+static const unsigned long fn(power10,l)[10] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+  };
+
+/* The largest values that can be multiplied by the corresponding powers
+   of ten without overflowing.  */
+static const unsigned value_t fn(limit10,l)[10] = {
+  MAXIMUM, MAXIMUM / 10, MAXIMUM / 100, MAXIMUM / 1000, MAXIMUM / 10000,
+  MAXIMUM / 100000, MAXIMUM / 1000000, MAXIMUM / 10000000,
+  MAXIMUM / 100000000, MAXIMUM / 1000000000
+  };
+
+/* Convert the decimal digits at S, storing the value in *NP and setting
+   OVERFLOW in *STATEP if it doesn't fit.  Returns the end of the digits.  */
+static const char *
+fn(decimal,l) (const char *s, unsigned value_t *np, int *statep) {
+  unsigned value_t n = 0;
+  int k;
+
+  do {
+    unsigned long chunk = 0;
+    unsigned int digit;
+
+    for (k = 0; k < 9 && (digit = digit_value (*s)) < 10; k++, s++)
+      chunk = 10 * chunk + digit;
+
+    if (k == 0)
+      break;
+    else if (n == 0)
+      n = chunk;
+    else if (n <= fn(limit10,l)[k]) {
+      n = n * fn(power10,l)[k] + chunk;
+      if (n < chunk)
+	*statep |= OVERFLOW;
+      }
+    else
+      *statep |= OVERFLOW;
+    } while (k == 9);
+
+  *np = n;
+  return s;
+  }
+
+#endif
 #ifdef Latoi
 
 int
@@ -38,8 +97,9 @@ atoi (const char *s) {
 
 value_t
 fn(atol,l) (const char *s) {
-  value_t n = 0;
+  value_t n;
   char sign;
+  int state = 0;
 
   while (isspace (*s))
     s++;
@@ -48,38 +108,23 @@ fn(atol,l) (const char *s) {
   if (sign == '+' || sign == '-')
     s++;
 
-  while (isdigit (*s))
-    n = 10 * n + *s++ - '0';
+  fn(decimal,l) (s, (unsigned value_t *) &n, &state);
 
   return (sign == '-')? -n : +n;
   }
 
 #endif
 
-#define NEGATIVE  0x01
-#define OVERFLOW  0x02
-
 unsigned value_t fn(_Strtoul,l) (int *, const char *, char **, int);
 
 #if defined L_Strtoul || defined L_Strtoull
 
-static inline unsigned int
-decode_digit (unsigned char c) {
-  if (c >= 'a')
-    return c - 'a' + 10;
-  else if (c >= 'A')
-    return c - 'A' + 10;
-  else if (c >= '0' && c <= '9')
-    return c - '0';
-  else
-    return 36;
-  }
-
 unsigned value_t
 fn(_Strtoul,l) (int *statep, const char *nptr, char **endptr, int base) {
   unsigned value_t n = 0;
   const char *s, *subject;
-  int digit, state = 0;
+  unsigned int digit;
+  int state = 0;
 
   s = nptr;
   while (isspace (*s))
@@ -103,19 +148,36 @@ fn(_Strtoul,l) (int *statep, const char *nptr, char **endptr, int base) {
 
   subject = s;
 
-  while ((digit = decode_digit (*s)) < base) {
-    unsigned value_t newn = n * base + digit;
-    if (newn < n)
-      state |= OVERFLOW;
-    n = newn;
-    s++;
+  if (base == 10)
+    s = fn(decimal,l) (s, &n, &state);
+  else if (base == 16) {
+    /* Shifting needs no library calls, even for "long long".  */
+    while ((digit = digit_value (*s)) < 16) {
+      if (n >> (CHAR_BIT * sizeof (value_t) - 4))
+	state |= OVERFLOW;
+      else
+	n = (n << 4) | digit;
+      s++;
+      }
+    }
+  else if (base >= 2 && base <= 36) {
+    unsigned value_t cutoff = MAXIMUM / base;
+    unsigned int cutlim = MAXIMUM % base;
+
+    while ((digit = digit_value (*s)) < base) {
+      if (n > cutoff || (n == cutoff && digit > cutlim))
+	state |= OVERFLOW;
+      else
+	n = n * base + digit;
+      s++;
+      }
     }
 
   if (endptr)
     *endptr = (char *) ((s > subject)? s : nptr);
 
   *statep = state;
-  return (state & OVERFLOW)? (BOUNDARY - 1) * 2 + 1 : n;
+  return (state & OVERFLOW)? MAXIMUM : n;
   }
 
 #endif
@@ -140,7 +202,7 @@ fn(strtol,l) (const char *nptr, char **endptr, int base) {
     n = +nu;
     }
 
-  /* FIXME Set OVERFLOW above, and check it here and signal via errno.  */
+  /* FIXME Signal overflow via errno.  */
 
   return n;
   }
@@ -153,7 +215,10 @@ fn(strtoul,l) (const char *nptr, char **endptr, int base) {
   int state;
   unsigned value_t n = fn(_Strtoul,l) (&state, nptr, endptr, base);
 
-  /* FIXME Check OVERFLOW and signal it via errno.  */
+  /* FIXME Signal OVERFLOW via errno.  */
+
+  if (state & OVERFLOW)
+    return n;
 
   return (state & NEGATIVE)? -n : +n;
   }
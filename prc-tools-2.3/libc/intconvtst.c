@@ -0,0 +1,194 @@
+/* Host-side conformance tests for the intconv.c conversion functions.
+
+   This is built with the host's compiler (see the intconvtst target in
+   Makefile.in), and the library's atol, strtol, strtoul and their "long
+   long" counterparts are compared with the host's own, which are assumed
+   to conform to the Standard, apart from errno.  The host's long is
+   likely to be wider than Palm OS's, but all the code involved depends on
+   the type's size only through sizeof.
+
+   This code is in the public domain.  */
+
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+/* The library's functions, under different names.  */
+
+#define atoi	lib_atoi
+#define atol	lib_atol
+#define atoll	lib_atoll
+#define strtol	lib_strtol
+#define strtoll	lib_strtoll
+#define strtoul	lib_strtoul
+#define strtoull lib_strtoull
+
+#define Lctype
+#include "ctype.c"
+#undef Lctype
+
+#define Latol
+#define L_Strtoul
+#define Lstrtol
+#define Lstrtoul
+#include "intconv.c"
+#undef Latol
+#undef L_Strtoul
+#undef Lstrtol
+#undef Lstrtoul
+#undef value_t
+#undef fn
+
+#define LONG_LONG
+#define Latoll
+#define L_Strtoull
+#define Lstrtoll
+#define Lstrtoull
+#include "intconv.c"
+
+#undef atoi
+#undef atol
+#undef atoll
+#undef strtol
+#undef strtoll
+#undef strtoul
+#undef strtoull
+
+/* The host's functions.  Its <stdlib.h> clashes with ours, so they are
+   declared here.  */
+
+long atol (const char *);
+long long atoll (const char *);
+long strtol (const char *, char **, int);
+long long strtoll (const char *, char **, int);
+unsigned long strtoul (const char *, char **, int);
+unsigned long long strtoull (const char *, char **, int);
+
+static int failures, tests;
+
+static void
+check (const char *what, const char *s, int base, unsigned long long got,
+       unsigned long long expected, const char *gotend, const char *end) {
+  tests++;
+  if (got != expected || gotend != end) {
+    printf ("%s (\"%s\", %d): got %llu end %d, expected %llu end %d\n",
+	    what, s, base, got, (int) (gotend - s), expected, (int) (end - s));
+    failures++;
+    }
+  }
+
+static void
+test (const char *s, int base) {
+  char *end, *gotend;
+  unsigned long long got, expected;
+
+  got = lib_strtol (s, &gotend, base);
+  expected = strtol (s, &end, base);
+  check ("strtol", s, base, got, expected, gotend, end);
+
+  got = lib_strtoul (s, &gotend, base);
+  expected = strtoul (s, &end, base);
+  check ("strtoul", s, base, got, expected, gotend, end);
+
+  got = lib_strtoll (s, &gotend, base);
+  expected = strtoll (s, &end, base);
+  check ("strtoll", s, base, got, expected, gotend, end);
+
+  got = lib_strtoull (s, &gotend, base);
+  expected = strtoull (s, &end, base);
+  check ("strtoull", s, base, got, expected, gotend, end);
+
+  /* The ato* functions are undefined on overflow, and don't take a base.  */
+  if (base == 10 && strtol (s, NULL, 10) != LONG_MAX
+      && strtol (s, NULL, 10) != LONG_MIN) {
+    check ("atol", s, base, lib_atol (s), atol (s), NULL, NULL);
+    check ("atoll", s, base, lib_atoll (s), atoll (s), NULL, NULL);
+    }
+  }
+
+static const int bases[] = { 0, 2, 3, 8, 10, 16, 36 };
+
+#define NBASES  (sizeof bases / sizeof bases[0])
+
+static void
+test_all_bases (const char *s) {
+  unsigned int i;
+  for (i = 0; i < NBASES; i++)
+    test (s, bases[i]);
+  }
+
+static const char *const fixed[] = {
+  "", " ", "+", "-", "0", "-0", "+0", "1", "-1", "  \t\n42xyz", "+-1",
+  "0x", "0X", "0x1g", "0xg", "00x1", "0x0x1", "-0x7f", "0777", "0778",
+  "z", "Z", "zz", "1z", "019", "9", "10", "a", "f", "F", "g",
+  "123456789", "1234567890", "12345678901234567890",
+  "000000000000000000000000000000000000000001",
+  "99999999", "999999999", "9999999999", "99999999999999999",
+  "999999999999999999", "9999999999999999999", "99999999999999999999",
+  "18446744073709551615", "18446744073709551616", "18446744073709551625",
+  "184467440737095516150", "-18446744073709551615", "-18446744073709551616",
+  "9223372036854775807", "9223372036854775808", "-9223372036854775808",
+  "-9223372036854775809", "4294967295", "4294967296", "-4294967296",
+  "2147483647", "2147483648", "-2147483648", "-2147483649",
+  "0xffffffff", "0x100000000", "0xffffffffffffffff", "0x10000000000000000",
+  "0x8000000000000000", "-0x8000000000000000", "-0x8000000000000001",
+  "01777777777777777777777", "02000000000000000000000",
+  "1111111111111111111111111111111111111111111111111111111111111111",
+  "11111111111111111111111111111111111111111111111111111111111111111",
+  "3w5e11264sgsf", "3w5e11264sgsg", "zzzzzzzzzzzzzzzzz"
+  };
+
+static unsigned long seed = 1;
+
+static unsigned long
+rnd (unsigned long n) {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % n;
+  }
+
+/* Random strings that are mostly, but not always, numbers.  */
+static void
+random_string (char *s) {
+  static const char junk[] = " \t+-0123456789abcdefxXzZ";
+  int n = rnd (25), i = 0;
+
+  if (rnd (4) == 0)  s[i++] = ' ';
+  if (rnd (3) == 0)  s[i++] = "+-"[rnd (2)];
+  if (rnd (4) == 0)  s[i++] = '0', s[i++] = "xX"[rnd (2)];
+  while (n-- > 0)
+    s[i++] = (rnd (10) == 0)? junk[rnd (sizeof junk - 1)]
+			     : "0123456789abcdef"[rnd (rnd (3)? 10 : 16)];
+  s[i] = '\0';
+  }
+
+int
+main (void) {
+  char s[64];
+  unsigned long long v;
+  unsigned int i;
+  int k;
+
+  for (i = 0; i < sizeof fixed / sizeof fixed[0]; i++)
+    test_all_bases (fixed[i]);
+
+  /* Either side of every power of two and ten, in each base.  */
+  for (k = 0; k < 64; k++)
+    for (v = (1ULL << k) - 2; v != (1ULL << k) + 2; v++) {
+      sprintf (s, "%llu", v);  test_all_bases (s);
+      sprintf (s, "-%llu", v);  test_all_bases (s);
+      sprintf (s, "%#llx", v);  test_all_bases (s);
+      sprintf (s, "%#llo", v);  test_all_bases (s);
+      }
+  for (v = 1, k = 0; k < 20; k++, v *= 10) {
+    sprintf (s, "%llu", v - 1);  test_all_bases (s);
+    sprintf (s, "%llu0", v - 1);  test_all_bases (s);
+    }
+
+  for (i = 0; i < 200000; i++) {
+    random_string (s);
+    test_all_bases (s);
+    }
+
+  printf ("%d tests, %d failures\n", tests, failures);
+  return failures != 0;
+  }
@@ -72,3 +72,272 @@ realloc (void *ptr, size_t size) {
   }
 
 #endif
+#ifdef Lmpool
+
+/* Optional pool allocator, installed as libmpool.a.  Linking with -lmpool
+   replaces all four of the functions above with these, provided something
+   linked earlier refers to malloc.  operator new comes later, from libgcc
+   or libnoexcept.a, so programs should use -u malloc -lmpool.
+
+   Each MemPtrNew chunk costs a Memory Manager chunk header and a walk along
+   the heap's free list, which is painful for programs (particularly C++
+   ones) that make many tiny allocations.  Instead, requests of up to
+   POOL_MAX_SIZE bytes are rounded up to one of a small set of size classes
+   and carved out of POOL_SLAB_SIZE slabs, each of which holds objects of
+   a single size; larger requests still go straight to MemPtrNew.
+
+   The allocator's state lives in global variables, so unlike the default
+   functions these can only be used when globals are available.  */
+
+#define POOL_SLAB_SIZE	2048
+#define POOL_MAX_SIZE	256
+
+struct slab {
+  struct slab *next;	/* Next slab of this class with a free object.  */
+  void *free;		/* Objects that have been freed in this slab.  */
+  char *unused;		/* Start of the never-allocated objects.  */
+  UInt16 size;		/* Object size for this slab's size class.  */
+  UInt16 used;		/* Number of objects currently allocated.  */
+  };
+
+#define SLAB_END(s)	((char *) (s) + POOL_SLAB_SIZE)
+
+static const UInt16 class_size[] = {
+  8, 12, 16, 20, 24, 32, 40, 48, 64, 80, 96, 128, 160, 192, 256
+  };
+
+#define NCLASSES  (sizeof class_size / sizeof class_size[0])
+
+/* Size class for each request size, indexed by (size + 3) / 4.  */
+static const UInt8 class_of[POOL_MAX_SIZE / 4 + 1] = {
+  0, 0, 0,					/*   0..  8 */
+  1,						/*   9.. 12 */
+  2,						/*  13.. 16 */
+  3,						/*  17.. 20 */
+  4,						/*  21.. 24 */
+  5, 5,						/*  25.. 32 */
+  6, 6,						/*  33.. 40 */
+  7, 7,						/*  41.. 48 */
+  8, 8, 8, 8,					/*  49.. 64 */
+  9, 9, 9, 9,					/*  65.. 80 */
+  10, 10, 10, 10,				/*  81.. 96 */
+  11, 11, 11, 11, 11, 11, 11, 11,		/*  97..128 */
+  12, 12, 12, 12, 12, 12, 12, 12,		/* 129..160 */
+  13, 13, 13, 13, 13, 13, 13, 13,		/* 161..192 */
+  14, 14, 14, 14, 14, 14, 14, 14,
+  14, 14, 14, 14, 14, 14, 14, 14		/* 193..256 */
+  };
+
+/* Slabs with at least one free object, for each size class.  */
+static struct slab *partial[NCLASSES];
+
+/* All slabs, sorted by address, so that free() can tell which (if any)
+   contains a given pointer.  */
+static struct slab **slabs;
+static UInt16 nslabs, maxslabs;
+
+/* The slab found by the most recent lookup.  */
+static struct slab *last_slab;
+
+static struct slab *
+find_slab (void *ptr) {
+  char *p = ptr;
+  UInt16 lo, hi;
+
+  if (last_slab && p > (char *) last_slab && p < SLAB_END (last_slab))
+    return last_slab;
+
+  /* Find the last slab starting below PTR.  */
+  lo = 0, hi = nslabs;
+  while (lo < hi) {
+    UInt16 mid = (lo + hi) / 2;
+    if ((char *) slabs[mid] < p)  lo = mid + 1;
+    else  hi = mid;
+    }
+
+  if (lo > 0 && p < SLAB_END (slabs[lo - 1]))
+    return last_slab = slabs[lo - 1];
+
+  return NULL;
+  }
+
+static struct slab *
+new_slab (UInt16 size) {
+  struct slab *s;
+  UInt16 i;
+
+  if (nslabs == maxslabs) {
+    UInt16 newmax = maxslabs + 16;
+    struct slab **newslabs;
+
+    if (slabs && MemPtrResize (slabs, newmax * sizeof *slabs) == 0)
+      newslabs = slabs;
+    else if ((newslabs = MemPtrNew (newmax * sizeof *slabs)) != NULL) {
+      if (slabs) {
+	MemMove (newslabs, slabs, nslabs * sizeof *slabs);
+	MemPtrFree (slabs);
+	}
+      }
+    else
+      return NULL;
+
+    slabs = newslabs;
+    maxslabs = newmax;
+    }
+
+  s = MemPtrNew (POOL_SLAB_SIZE);
+  if (s == NULL)
+    return NULL;
+
+  s->next = NULL;
+  s->free = NULL;
+  s->unused = (char *) (s + 1);
+  s->size = size;
+  s->used = 0;
+
+  for (i = nslabs; i > 0 && slabs[i - 1] > s; i--)
+    slabs[i] = slabs[i - 1];
+  slabs[i] = s;
+  nslabs++;
+
+  return s;
+  }
+
+static void
+release_slab (struct slab *s) {
+  UInt16 i;
+
+  for (i = 0; slabs[i] != s; i++)
+    ;
+  for (nslabs--; i < nslabs; i++)
+    slabs[i] = slabs[i + 1];
+
+  if (last_slab == s)
+    last_slab = NULL;
+
+  MemPtrFree (s);
+  }
+
+static int
+slab_full (struct slab *s) {
+  return s->free == NULL && s->unused + s->size > SLAB_END (s);
+  }
+
+static void
+pool_free (struct slab *s, void *ptr) {
+  UInt8 c = class_of[(s->size + 3) / 4];
+
+  if (slab_full (s)) {
+    s->next = partial[c];
+    partial[c] = s;
+    }
+
+  *(void **) ptr = s->free;
+  s->free = ptr;
+
+  /* Give empty slabs back to the Memory Manager, except for the one at
+     the head of the list, which is kept to avoid thrashing when a single
+     object is repeatedly allocated and freed.  */
+  if (--s->used == 0 && partial[c] != s) {
+    struct slab *prev = partial[c];
+    while (prev->next != s)
+      prev = prev->next;
+    prev->next = s->next;
+    release_slab (s);
+    }
+  }
+
+void *
+malloc (size_t size) {
+  struct slab *s;
+  void *p;
+  UInt8 c;
+
+  if (size == 0)
+    return NULL;
+  else if (size > POOL_MAX_SIZE)
+    return MemPtrNew (size);
+
+  c = class_of[(size + 3) / 4];
+  s = partial[c];
+  if (s == NULL) {
+    s = new_slab (class_size[c]);
+    if (s == NULL)
+      return NULL;
+    partial[c] = s;
+    }
+
+  if (s->free) {
+    p = s->free;
+    s->free = *(void **) p;
+    }
+  else {
+    p = s->unused;
+    s->unused += s->size;
+    }
+
+  s->used++;
+  if (slab_full (s))
+    partial[c] = s->next;
+
+  return p;
+  }
+
+void
+free (void *ptr) {
+  struct slab *s;
+
+  if (ptr == NULL)
+    return;
+  else if ((s = find_slab (ptr)) != NULL)
+    pool_free (s, ptr);
+  else
+    MemPtrFree (ptr);
+  }
+
+void *
+calloc (size_t nmemb, size_t memb_size) {
+  size_t size = nmemb * memb_size;
+  void *ptr = malloc (size);
+  if (ptr)
+    MemSet (ptr, size, 0);
+  return ptr;
+  }
+
+void *
+realloc (void *ptr, size_t size) {
+  struct slab *s;
+  void *newptr;
+
+  if (ptr == NULL)
+    return malloc (size);
+  else if (size == 0) {
+    free (ptr);
+    return NULL;
+    }
+  else if ((s = find_slab (ptr)) != NULL) {
+    /* Any size up to the object's size class can be accommodated without
+       moving it.  */
+    if (size <= s->size)
+      return ptr;
+
+    newptr = malloc (size);
+    if (newptr) {
+      MemMove (newptr, ptr, s->size);
+      pool_free (s, ptr);
+      }
+    return newptr;
+    }
+  else if (MemPtrResize (ptr, size) == 0)
+    return ptr;
+  else {
+    newptr = MemPtrNew (size);
+    if (newptr) {
+      MemMove (newptr, ptr, MemPtrSize (ptr));
+      MemPtrFree (ptr);
+      }
+    return newptr;
+    }
+  }
+
+#endif
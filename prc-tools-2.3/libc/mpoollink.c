@@ -0,0 +1,26 @@
+/* Link order check for libmpool.a (see the check-mpool-link target in
+   Makefile.in).  Lopnew stands in for operator new, which reaches malloc
+   from a library linked after the user's -lmpool; the rest is a program
+   that only uses new.
+
+   This code is in the public domain.  */
+
+#include <stdlib.h>
+
+#ifdef Lopnew
+
+void *
+opnew (size_t size) {
+  return malloc (size);
+  }
+
+#else
+
+extern void *opnew (size_t size);
+
+void *
+make_node (void) {
+  return opnew (16);
+  }
+
+#endif
@@ -0,0 +1,415 @@
+/* Host-side tests and benchmark for the malloc.c allocators.
+
+   This is built with the host's compiler against the bootstrap headers
+   (see the mpooltst target in Makefile.in), and both the default
+   MemPtrNew-based functions and the libmpool.a pool allocator are run
+   against a simulated Memory Manager.  Like the real one, the simulation
+   puts a header on every chunk and walks the heap to find a free chunk,
+   and it counts how much of that work each allocator causes.
+
+   This code is in the public domain.  */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "bootstrap.h"
+
+/* Simulated Memory Manager.  */
+
+#define HEAP_SIZE  (512 * 1024L)
+
+struct chunk {
+  UInt32 size;		/* Size of the whole chunk, including this header.  */
+  UInt32 req;		/* Size requested, or 0 if the chunk is free.  */
+  };
+
+#define HDR	sizeof (struct chunk)
+#define ROUND(n)  (((n) + HDR + 7) & ~7UL)
+
+static union { struct chunk c; double align; char bytes[HEAP_SIZE]; } heap;
+
+static struct {
+  unsigned long calls;		/* Memory Manager calls made.  */
+  unsigned long steps;		/* Chunks visited while searching.  */
+  unsigned long chunks;		/* Chunks currently allocated.  */
+  unsigned long used, peak;	/* Heap bytes currently and at most in use.  */
+  } mm;
+
+#define NEXT(c)  ((struct chunk *) ((char *) (c) + (c)->size))
+#define HEAP_END ((struct chunk *) (heap.bytes + HEAP_SIZE))
+
+static void
+mm_reset (void) {
+  memset (&mm, 0, sizeof mm);
+  heap.c.size = HEAP_SIZE;
+  heap.c.req = 0;
+  }
+
+/* Merge any free chunks following C into it.  */
+static void
+coalesce (struct chunk *c) {
+  struct chunk *n;
+  while ((n = NEXT (c)) < HEAP_END && n->req == 0)
+    c->size += n->size;
+  }
+
+static void
+split (struct chunk *c, UInt32 size) {
+  if (c->size - size >= ROUND (1)) {
+    struct chunk *rest = (struct chunk *) ((char *) c + size);
+    rest->size = c->size - size;
+    rest->req = 0;
+    c->size = size;
+    coalesce (rest);
+    }
+  }
+
+MemPtr
+MemPtrNew (UInt32 req) {
+  UInt32 size = ROUND (req);
+  struct chunk *c;
+
+  mm.calls++;
+  if (req == 0)
+    return NULL;
+
+  for (c = &heap.c; c < HEAP_END; c = NEXT (c)) {
+    mm.steps++;
+    if (c->req == 0) {
+      coalesce (c);
+      if (c->size >= size) {
+	split (c, size);
+	c->req = req;
+	mm.chunks++;
+	mm.used += c->size;
+	if (mm.used > mm.peak)  mm.peak = mm.used;
+	return c + 1;
+	}
+      }
+    }
+
+  return NULL;
+  }
+
+Err
+MemPtrFree (MemPtr p) {
+  struct chunk *c = (struct chunk *) p - 1;
+  mm.calls++;
+  mm.chunks--;
+  mm.used -= c->size;
+  c->req = 0;
+  return 0;
+  }
+
+UInt32
+MemPtrSize (MemPtr p) {
+  mm.calls++;
+  return ((struct chunk *) p - 1)->req;
+  }
+
+Err
+MemPtrResize (MemPtr p, UInt32 req) {
+  struct chunk *c = (struct chunk *) p - 1;
+  UInt32 size = ROUND (req);
+  struct chunk *n;
+
+  mm.calls++;
+  mm.used -= c->size;
+  if (size > c->size && (n = NEXT (c)) < HEAP_END && n->req == 0) {
+    coalesce (n);
+    if (c->size + n->size >= size)
+      c->size += n->size;
+    }
+
+  if (size <= c->size) {
+    split (c, size);
+    c->req = req;
+    }
+
+  mm.used += c->size;
+  if (mm.used > mm.peak)  mm.peak = mm.used;
+  return (c->req == req)? 0 : 0x0102;  /* memErrNotEnoughSpace */
+  }
+
+Err
+MemMove (void *dst, const void *src, UInt32 n) {
+  memmove (dst, src, n);
+  return 0;
+  }
+
+Err
+MemSet (void *dst, UInt32 n, UInt8 c) {
+  memset (dst, c, n);
+  return 0;
+  }
+
+/* The allocators under test.  */
+
+#define malloc	mm_malloc
+#define free	mm_free
+#define calloc	mm_calloc
+#define realloc	mm_realloc
+#define Lmalloc
+#define Lfree
+#define Lcalloc
+#define Lrealloc
+#include "malloc.c"
+#undef Lmalloc
+#undef Lfree
+#undef Lcalloc
+#undef Lrealloc
+#undef malloc
+#undef free
+#undef calloc
+#undef realloc
+
+#define malloc	mp_malloc
+#define free	mp_free
+#define calloc	mp_calloc
+#define realloc	mp_realloc
+#define Lmpool
+#include "malloc.c"
+#undef malloc
+#undef free
+#undef calloc
+#undef realloc
+
+/* Start again with an empty heap.  */
+static void
+reset (void) {
+  mm_reset ();
+  memset (partial, 0, sizeof partial);
+  slabs = NULL;
+  nslabs = maxslabs = 0;
+  last_slab = NULL;
+  }
+
+struct allocator {
+  const char *name;
+  void *(*malloc) (size_t);
+  void (*free) (void *);
+  void *(*calloc) (size_t, size_t);
+  void *(*realloc) (void *, size_t);
+  };
+
+static const struct allocator allocators[] = {
+  { "MemPtrNew", mm_malloc, mm_free, mm_calloc, mm_realloc },
+  { "mpool", mp_malloc, mp_free, mp_calloc, mp_realloc }
+  };
+
+static unsigned long seed;
+
+static unsigned long
+rnd (unsigned long n) {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % n;
+  }
+
+/* Small sizes dominate, as they do for C++ containers and strings.  */
+static size_t
+rnd_size (void) {
+  unsigned long r = rnd (100);
+  if (r < 60)  return 1 + rnd (24);
+  else if (r < 90)  return 1 + rnd (POOL_MAX_SIZE);
+  else  return 1 + rnd (2000);
+  }
+
+static int failures;
+
+#define CHECK(cond) \
+  do { if (! (cond)) { \
+    printf ("%s:%d: %s: check failed: %s\n", \
+	    __FILE__, __LINE__, a->name, #cond); \
+    failures++; \
+    } } while (0)
+
+#define NSLOTS	500
+
+static struct { unsigned char *p; size_t size; unsigned char fill; }
+  slot[NSLOTS];
+
+static int
+slot_ok (int i) {
+  size_t j;
+  for (j = 0; j < slot[i].size; j++)
+    if (slot[i].p[j] != slot[i].fill)
+      return 0;
+  return 1;
+  }
+
+static void
+test_basic (const struct allocator *a) {
+  unsigned char *p, *q;
+  size_t i;
+
+  reset ();
+
+  CHECK (a->malloc (0) == NULL);
+  a->free (NULL);
+
+  p = a->calloc (10, 7);
+  CHECK (p != NULL);
+  for (i = 0; i < 70; i++)
+    CHECK (p[i] == 0);
+  a->free (p);
+
+  p = a->realloc (NULL, 5);
+  CHECK (p != NULL);
+  memcpy (p, "abcd", 5);
+  q = a->realloc (p, 3000);
+  CHECK (q != NULL && memcmp (q, "abcd", 5) == 0);
+  p = a->realloc (q, 2);
+  CHECK (p != NULL && memcmp (p, "ab", 2) == 0);
+  CHECK (a->realloc (p, 0) == NULL);
+
+  CHECK (mm.chunks <= NCLASSES + 1);
+  }
+
+static void
+test_pool_realloc (const struct allocator *a) {
+  unsigned char *p, *q;
+  size_t i;
+
+  reset ();
+
+  /* Growth within the size class happens in place.  */
+  p = a->malloc (5);
+  memcpy (p, "wxyz", 5);
+  CHECK (a->realloc (p, 8) == p);
+
+  /* Growth beyond it moves the object, preserving its contents.  */
+  q = a->realloc (p, 9);
+  CHECK (q != NULL && memcmp (q, "wxyz", 5) == 0);
+
+  for (i = 9; i <= POOL_MAX_SIZE; i++) {
+    q = a->realloc (q, i);
+    q[i - 1] = (unsigned char) i;
+    CHECK (q[i - 2] == (unsigned char) (i - 1) || i == 9);
+    }
+  CHECK (memcmp (q, "wxyz", 5) == 0);
+
+  /* Then out into a Memory Manager chunk.  */
+  q = a->realloc (q, 1000);
+  CHECK (q != NULL && memcmp (q, "wxyz", 5) == 0);
+
+  /* An empty slab is kept for each class passed through, as well as the
+     slab table and the large chunk itself.  */
+  CHECK (mm.chunks <= NCLASSES + 2);
+  a->free (q);
+  }
+
+static void
+test_random (const struct allocator *a) {
+  unsigned long n;
+  int i;
+
+  reset ();
+  seed = 1;
+  memset (slot, 0, sizeof slot);
+
+  for (n = 0; n < 200000; n++) {
+    i = rnd (NSLOTS);
+    if (slot[i].p) {
+      CHECK (slot_ok (i));
+      if (rnd (4) == 0) {
+	size_t size = rnd_size ();
+	unsigned char *p = a->realloc (slot[i].p, size);
+	CHECK (p != NULL);
+	if (size < slot[i].size)  slot[i].size = size;
+	slot[i].p = p;
+	CHECK (slot_ok (i));
+	slot[i].size = size;
+	memset (p, slot[i].fill, size);
+	}
+      else {
+	a->free (slot[i].p);
+	slot[i].p = NULL;
+	}
+      }
+    else {
+      slot[i].size = rnd_size ();
+      slot[i].fill = rnd (256);
+      slot[i].p = a->malloc (slot[i].size);
+      CHECK (slot[i].p != NULL);
+      memset (slot[i].p, slot[i].fill, slot[i].size);
+      }
+    }
+
+  for (i = 0; i < NSLOTS; i++)
+    if (slot[i].p) {
+      CHECK (slot_ok (i));
+      a->free (slot[i].p);
+      }
+
+  /* At most one slab per class, and the slab table, should remain.  */
+  CHECK (mm.chunks <= NCLASSES + 1);
+  }
+
+static void
+test_exhaustion (const struct allocator *a) {
+  void *p;
+  unsigned long n = 0;
+
+  reset ();
+  while ((p = a->malloc (1 + n % 100)) != NULL)
+    n++;
+  CHECK (n > HEAP_SIZE / 128);
+  }
+
+/* Benchmark: build and tear down lists of small nodes and strings, as
+   a C++ program using std::list<std::string> would.  */
+
+#define NNODES	3000
+
+static void
+bench (const struct allocator *a) {
+  static void *node[NNODES], *str[NNODES];
+  clock_t start;
+  int round, i;
+
+  reset ();
+  seed = 2;
+  start = clock ();
+
+  for (round = 0; round < 10; round++) {
+    for (i = 0; i < NNODES; i++) {
+      node[i] = a->malloc (12);
+      str[i] = a->malloc (8 + rnd (32));
+      }
+    for (i = 0; i < NNODES; i += 2) {
+      a->free (str[i]);
+      str[i] = a->malloc (8 + rnd (32));
+      }
+    for (i = 0; i < NNODES; i++) {
+      a->free (node[i]);
+      a->free (str[i]);
+      }
+    }
+
+  printf ("%-10s %10lu %12lu %10lu %8.2fs\n", a->name, mm.calls, mm.steps,
+	  mm.peak, (double) (clock () - start) / CLOCKS_PER_SEC);
+  }
+
+int
+main (void) {
+  size_t i;
+
+  for (i = 0; i < sizeof allocators / sizeof allocators[0]; i++) {
+    const struct allocator *a = &allocators[i];
+    test_basic (a);
+    test_random (a);
+    test_exhaustion (a);
+    }
+
+  test_pool_realloc (&allocators[1]);
+
+  printf ("%d failures\n\n", failures);
+
+  printf ("%-10s %10s %12s %10s %9s\n",
+	  "allocator", "MM calls", "heap walked", "peak heap", "time");
+  for (i = 0; i < sizeof allocators / sizeof allocators[0]; i++)
+    bench (&allocators[i]);
+
+  return failures != 0;
+  }
@@ -1,25 +1,23 @@
-#ifdef BOOTSTRAP
-#include "bootstrap.h"
-#else
-#include <StringMgr.h>
-#endif
-
 #include <stdio.h>
-#include <string.h>
-#include <ctype.h>
+
+/* Formatted output goes straight into the console, in runs.  */
+static void console(void *cookie, const char *s, size_t n)
+{
+  _Conwrite(s, n);
+}
+
+int vprintf(const char *fmt, va_list args)
+{
+  return _Vformat(console, NULL, fmt, args);
+}
 
 int printf(const char *fmt, ...)
 {
   va_list args;
   int i;
-  int j;
-  char buf[128];
 
   va_start(args, fmt);
-  i=vsprintf(buf,fmt,args);
+  i=vprintf(fmt,args);
   va_end(args);
-  for (j=0;j<StrLen(buf);j++) {
-    putchar(buf[j]);
-  }
   return i;
 }
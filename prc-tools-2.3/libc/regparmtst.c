@@ -0,0 +1,240 @@
+/* regparmtst.c: checks that -mregparm's register argument passing works in
+   each way a static function can be reached.
+
+   The regparmtst.prc target in Makefile.in builds this as a Palm OS
+   application with -mregparm=$(REGPARM), by default 5; it lists any checks
+   that fail.  Build it with REGPARM=2 as well, which leaves some functions
+   below on the stack and makes others mix data and address registers.
+   Built for the host, the same checks confirm the expected values.
+
+   The functions are called directly, with arguments that are themselves
+   register argument calls; through pointers taken in code, which go via
+   the `.stack' entry points; through pointers in initialized data, both
+   constant and writable; after an inline function's indirect call has
+   been made direct; under an assembler name given by an asm declaration;
+   and before their prototype has been seen, when they keep to the stack.  A static function with a callseq attribute also
+   keeps to the stack, since the sequence is its real calling convention.
+
+   This code is in the public domain.  */
+
+#ifdef __palmos__
+#include <SystemMgr.h>
+#include <Window.h>
+#include <StringMgr.h>
+
+#include <NewTypes.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <string.h>
+
+static int failures = 0;
+
+static void console (const char *text);
+
+static void
+check (const char *name, long got, long expected) {
+  if (got != expected) {
+    console (name);
+    failures++;
+    }
+  }
+
+/* Called before its prototype, so it takes its arguments on the stack
+   even though it would qualify.  */
+static long late ();
+
+static long
+call_late (void) {
+  return late (7L, 5L);
+  }
+
+/* Called by its callseq, which pushes the arguments.  */
+long seq_target (long a, long b);
+
+#ifdef __m68k__
+static long via_seq (long a, long b)
+  __attribute__ ((callseq ("jsr seq_target")));
+#else
+#define via_seq  seq_target
+#endif
+
+long
+seq_target (long a, long b) {
+  return a * 100 + b;
+  }
+
+static int
+add2 (int a, int b) {
+  return a + b;
+  }
+
+static int
+sub2 (int a, int b) {
+  return a - b;
+  }
+
+static long
+mixed3 (signed char c, short s, long l) {
+  return c * 10000L + s * 100L + l;
+  }
+
+/* Three pointers: the third overflows A0/A1 into a data register.  */
+static long
+ptrs3 (const int *p, const int *q, const int *r) {
+  return *p * 100 + *q * 10 + *r;
+  }
+
+static long
+five (long a, const char *s, short b, const long *p, unsigned char c) {
+  return a + *s + b * 10 + *p * 100 + c * 1000L;
+  }
+
+static float
+scale (float f, int n) {
+  return f * n;
+  }
+
+/* Six arguments are always more than -mregparm allows.  */
+static long
+six (int a, int b, int c, int d, int e, int f) {
+  return ((((a * 10L + b) * 10 + c) * 10 + d) * 10 + e) * 10 + f;
+  }
+
+/* Its assembler name is used verbatim, so its symbol starts with `*'.  */
+static int asm_named (int a, int b) asm ("asm_named_g");
+
+static int
+asm_named (int a, int b) {
+  return a * 10 + b;
+  }
+
+static int
+fact (int n) {
+  return (n <= 1)? 1 : n * fact (n - 1);
+  }
+
+static void
+store (long *p, long v) {
+  *p = v;
+  }
+
+static long
+late (long a, long b) {
+  return a * 10 - b;
+  }
+
+typedef int binop (int, int);
+
+static binop *const const_ops[] = { add2, sub2 };
+static binop *ops[] = { sub2, add2 };
+
+static const struct {
+  const char *name;
+  long (*fn) (signed char, short, long);
+  } named = { "mixed3", mixed3 };
+
+static inline int
+apply (binop *fn, int a, int b) {
+  return fn (a, b);
+  }
+
+static int
+apply_outline (binop *fn, int a, int b) {
+  return fn (a, b);
+  }
+
+static void
+run_checks (void) {
+  static const int i1 = 1, i2 = 2, i3 = 3;
+  static const long l4 = 4;
+  char a[2] = "a";
+  binop *volatile fp;
+  long result;
+  int i;
+
+  /* Direct calls, with register arguments computed by other such calls
+     and by ordinary library calls.  */
+  check ("add2", add2 (3, 4), 7);
+  check ("nested", add2 (sub2 (10, 3), add2 (sub2 (1, 2), 5)), 11);
+  check ("mixed3", mixed3 (-3, 45, 67), -25433);
+  check ("ptrs3", ptrs3 (&i1, &i2, &i3), 123);
+  check ("five", five (5, "A", -2, &l4, 200), 200000L + 5 + 'A' - 20 + 400);
+  check ("five/strlen",
+	 five (strlen ("abc"), a + strlen (""), add2 (1, 1), &l4, 3),
+	 3 + 'a' + 20 + 400 + 3000);
+  check ("scale", (long) scale (2.5f, 4), 10);
+  check ("six", six (1, 2, 3, 4, 5, 6), 123456);
+  check ("asm name", asm_named (4, 2), 42);
+  check ("fact", fact (7), 5040);
+  store (&result, 42);
+  check ("store", result, 42);
+
+  /* Through pointers, which reach the functions by their .stack entry
+     points.  */
+  fp = add2;
+  check ("pointer", fp (20, 22), 42);
+  fp = sub2;
+  check ("pointer2", fp (20, 22), -2);
+  fp = asm_named;
+  check ("asm name pointer", fp (2, 4), 24);
+  check ("const table", const_ops[0] (6, 3) * 10 + const_ops[1] (6, 3), 93);
+  check ("data table", ops[0] (6, 3) * 10 + ops[1] (6, 3), 39);
+  ops[0] = add2;
+  check ("data table store", ops[0] (6, 3), 9);
+  check ("struct", named.fn (1, 2, 3), 10203);
+  check ("outline", apply_outline (add2, 8, 9), 17);
+  check ("inline", apply (sub2, 8, 9), -1);
+  for (i = result = 0; i < 2; i++)
+    result = result * 100 + apply (const_ops[i], 50, i);
+  check ("inline loop", result, 5049);
+
+  /* Functions that keep to the stack.  */
+  check ("late", call_late (), 65);
+  check ("callseq", via_seq (12, 34), 1234);
+  }
+
+
+#ifdef __palmos__
+
+static void
+console (const char *text) {
+  static Int16 y = 0;
+  WinDrawChars (text, StrLen (text), 0, y);
+  y += 10;
+  if (y >= 150)
+    y = 0;
+  }
+
+UInt32
+PilotMain (UInt16 cmd, void *cmdPBP __attribute__ ((unused)),
+	   UInt16 launchFlags __attribute__ ((unused))) {
+  if (cmd == sysAppLaunchCmdNormalLaunch) {
+    char line[40];
+
+    console ("Checking...");
+    run_checks ();
+    StrPrintF (line, "%d failures", failures);
+    console (line);
+    SysTaskDelay (30 * SysTicksPerSecond ());
+    }
+
+  return 0;
+  }
+
+#else
+
+static void
+console (const char *text) {
+  printf ("%s: failed\n", text);
+  }
+
+int
+main () {
+  run_checks ();
+  printf ("%d failures\n", failures);
+  return failures != 0;
+  }
+
+#endif
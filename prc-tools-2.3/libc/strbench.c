@@ -0,0 +1,178 @@
+/* strbench.c: cycle counts for the string68k.S functions and their C
+   equivalents from memstring.c and string.c.
+
+   This is a Palm OS application, built by the strbench.prc target in
+   Makefile.in.  Run it on a device or the Emulator; it times each function
+   at a range of sizes and displays the average cycles per call.  The
+   processor clock is measured against a dbra loop whose cycle count is
+   known, so the figures do not depend on knowing the device's clock rate.
+
+   This code is in the public domain.  */
+
+#include <SystemMgr.h>
+#include <TimeMgr.h>
+#include <Window.h>
+#include <StringMgr.h>
+
+#include <NewTypes.h>
+
+#include <string.h>
+
+/* Compile the C versions under different names, alongside the versions
+   from libc.a.  */
+
+#define memcpy	c_memcpy
+#define memmove	c_memmove
+#define memset	c_memset
+#define memcmp	c_memcmp
+#define Lmemcpy
+#define Lmemmove
+#define Lmemset
+#define Lmemcmp
+#include "memstring.c"
+#undef memcpy
+#undef memmove
+#undef memset
+#undef memcmp
+
+#define strcpy	c_strcpy
+#define strcmp	c_strcmp
+#define strlen	c_strlen
+#define Lstrcpy
+#define Lstrcmp
+#define Lstrlen
+#include "string.c"
+#undef strcpy
+#undef strcmp
+#undef strlen
+
+static void
+console (const char *text) {
+  static Int16 y = 0;
+  WinDrawChars (text, StrLen (text), 0, y);
+  y += 10;
+  }
+
+/* Each iteration of the dbra loop takes 10 cycles, and there are 65536
+   of them per call.  */
+static void
+spin (void) {
+  UInt16 n = 0xffff;
+  asm volatile ("1: dbra %0,1b" : "+d" (n));
+  }
+
+static UInt32 cycles_per_tick;
+
+static void
+calibrate (void) {
+  UInt32 start, ticks, n = 0;
+
+  start = TimGetTicks ();
+  do {
+    spin ();
+    n++;
+    ticks = TimGetTicks () - start;
+    } while (ticks < 2 * SysTicksPerSecond ());
+
+  cycles_per_tick = n * 655360UL / ticks;
+  }
+
+static char buf1[1024 + 1], buf2[1024 + 1];
+
+enum { MEMCPY, MEMMOVE, MEMSET, MEMCMP, STRCPY, STRCMP, STRLEN };
+
+static const char *const name[] = {
+  "memcpy", "memmove", "memset", "memcmp", "strcpy", "strcmp", "strlen"
+  };
+
+static void
+call (int fn, int use_asm, char *dst, const char *src, size_t n) {
+  switch (fn) {
+  case MEMCPY:
+    if (use_asm)  memcpy (dst, src, n);  else  c_memcpy (dst, src, n);
+    break;
+  case MEMMOVE:
+    if (use_asm)  memmove (dst, src, n);  else  c_memmove (dst, src, n);
+    break;
+  case MEMSET:
+    if (use_asm)  memset (dst, 'x', n);  else  c_memset (dst, 'x', n);
+    break;
+  case MEMCMP:
+    if (use_asm)  memcmp (dst, src, n);  else  c_memcmp (dst, src, n);
+    break;
+  case STRCPY:
+    if (use_asm)  strcpy (dst, src);  else  c_strcpy (dst, src);
+    break;
+  case STRCMP:
+    if (use_asm)  strcmp (dst, src);  else  c_strcmp (dst, src);
+    break;
+  case STRLEN:
+    if (use_asm)  strlen (src);  else  c_strlen (src);
+    break;
+    }
+  }
+
+/* Average cycles per call, including the call overhead.  */
+static UInt32
+measure (int fn, int use_asm, size_t n) {
+  char *dst = buf1;
+  const char *src = buf2;
+  UInt32 start, ticks, calls = 0;
+
+  c_memset (buf2, 'x', n);
+  buf2[n] = '\0';
+  c_memcpy (buf1, buf2, n + 1);
+
+  start = TimGetTicks ();
+  do {
+    int i;
+    for (i = 0; i < 16; i++)
+      call (fn, use_asm, dst, src, n);
+    calls += 16;
+    ticks = TimGetTicks () - start;
+    } while (ticks < SysTicksPerSecond () / 2);
+
+  return ticks * cycles_per_tick / calls;
+  }
+
+static const size_t sizes[] = { 4, 16, 64, 256, 1024 };
+
+#define NSIZES  (sizeof sizes / sizeof sizes[0])
+
+static void
+bench (int fn) {
+  char line[80];
+  unsigned int i;
+
+  StrPrintF (line, "%s C/asm:", name[fn]);
+  console (line);
+
+  line[0] = '\0';
+  for (i = 0; i < NSIZES; i++) {
+    char *p = line + StrLen (line);
+    StrPrintF (p, " %lu/%lu", measure (fn, 0, sizes[i]),
+	       measure (fn, 1, sizes[i]));
+    }
+  console (line);
+  }
+
+UInt32
+PilotMain (UInt16 cmd, void *cmdPBP __attribute__ ((unused)),
+	   UInt16 launchFlags __attribute__ ((unused))) {
+  if (cmd == sysAppLaunchCmdNormalLaunch) {
+    char line[80];
+    int fn;
+
+    calibrate ();
+    StrPrintF (line, "%lu cycles/tick; sizes 4 16 64 256 1K",
+	       cycles_per_tick);
+    console (line);
+
+    for (fn = MEMCPY; fn <= STRLEN; fn++)
+      bench (fn);
+
+    SysTaskDelay (30 * SysTicksPerSecond ());
+    }
+
+  return 0;
+  }
@@ -0,0 +1,106 @@
+/* strbencharm.c: cycle counts for the stringarm.S functions and their C
+   equivalents from memstring.c and string.c.
+
+   This is a bare ARM program for the simulator rather than an armlet: it
+   uses the Demon SWIs for output and to exit, and needs nothing from Palm
+   OS.  Build it with the strbencharm target in Makefile.in, then run it
+   under the profiling simulator and look at the flat profile:
+
+	arm-palmos-run --profile --profile-freq=1000000 strbencharm
+	arm-palmos-gprof -b -p strbencharm gmon.out
+
+   With that frequency each second of the profile is a million ARM7TDMI
+   cycles, so a function's self seconds divided by its calls, times a
+   million, is its cycles per call, excluding the call itself.  Each
+   function is called the same number of times; define BENCH_SIZE to pick
+   the size used, which is 64 by default.  Note that when memmove can copy
+   forwards it branches to memcpy, and the time is charged there.
+
+   This code is in the public domain.  */
+
+#include <string.h>
+
+/* Compile the C versions under different names, alongside the versions
+   from libc.a.  */
+
+#define memcpy	c_memcpy
+#define memmove	c_memmove
+#define memchr	c_memchr
+#define memset	c_memset
+#define Lmemcpy
+#define Lmemmove
+#define Lmemchr
+#define Lmemset
+#include "memstring.c"
+#undef memcpy
+#undef memmove
+#undef memchr
+#undef memset
+
+#define strcpy	c_strcpy
+#define strcmp	c_strcmp
+#define strchr	c_strchr
+#define strlen	c_strlen
+#define Lstrcpy
+#define Lstrcmp
+#define Lstrchr
+#define Lstrlen
+#include "string.c"
+#undef strcpy
+#undef strcmp
+#undef strchr
+#undef strlen
+
+asm ("	.text\n"
+     "	.global _start\n"
+     "_start:\n"
+     "	ldr sp, =0x200000\n"
+     "	bl main\n"
+     "	swi 0x11\n");		/* SWI_Exit */
+
+static void
+console (const char *text) {
+  asm volatile ("mov r0, %0; swi 0x2" : : "r" (text) : "r0");  /* SWI_Write0 */
+  }
+
+#ifndef BENCH_SIZE
+#define BENCH_SIZE  64
+#endif
+
+#define NCALLS	2000
+
+/* The source is offset by a word, as strings within structures often are;
+   memmove moves a block up by a word within the same buffer, so it copies
+   backwards unless the block is no longer than a word.  */
+static char buf1[BENCH_SIZE + 8], buf2[BENCH_SIZE + 8];
+
+int
+main (void) {
+  const size_t n = BENCH_SIZE;
+  char *dst = buf1, *src = buf2 + 4;
+  int i;
+
+  c_memset (buf2, 'x', n + 4);
+  src[n] = '\0';
+  c_memcpy (dst, src, n + 1);
+
+  for (i = 0; i < NCALLS; i++) {
+    c_memcpy (dst, src, n);
+    memcpy (dst, src, n);
+    c_memmove (buf2 + 4, buf2, n);
+    memmove (buf2 + 4, buf2, n);
+    c_memchr (src, 'y', n);
+    memchr (src, 'y', n);
+    c_strcpy (dst, src);
+    strcpy (dst, src);
+    c_strcmp (dst, src);
+    strcmp (dst, src);
+    c_strchr (src, 'y');
+    strchr (src, 'y');
+    c_strlen (src);
+    strlen (src);
+    }
+
+  console ("done\n");
+  return 0;
+  }
@@ -110,10 +110,41 @@ char * ftoa(char *st, float f, int flags)
 }
 #endif /* PRINT_FLOATS */
 
-static char * number(char * str, long num, int base, int size, int precision
-	,int type)
+/* Output goes to a sink, a function called with runs of characters, so
+ * that the same formatting code serves vsnprintf (into a bounded buffer),
+ * printf (straight into the console) and any caller of _Vformat.  */
+struct output {
+	void (*sink)(void *, const char *, size_t);
+	void *cookie;
+	size_t count;		/* characters output so far */
+};
+
+static void emit(struct output *out, const char *s, size_t n)
+{
+	if (n > 0) {
+		out->sink(out->cookie, s, n);
+		out->count += n;
+	}
+}
+
+static void pad(struct output *out, char c, int n)
+{
+	static const char spaces[] = "                ";
+	static const char zeros[]  = "0000000000000000";
+	const char *s = (c == '0') ? zeros : spaces;
+
+	while (n > 0) {
+		int k = (n < 16) ? n : 16;
+		emit(out, s, k);
+		n -= k;
+	}
+}
+
+static void number(struct output *out, long num, int base, int size,
+	int precision, int type)
 {
 	char c,sign,tmp[66];
+	char *t;
 	const char *digits="0123456789abcdefghijklmnopqrstuvwxyz";
 	int i;
 
@@ -122,7 +153,7 @@ static char * number(char * str, long num, int base, int size, int precision
 	if (type & LEFT)
 		type &= ~ZEROPAD;
 	if (base < 2 || base > 36)
-		return 0;
+		return;
 	c = (type & ZEROPAD) ? '0' : ' ';
 	sign = 0;
 	if (type & SIGN) {
@@ -144,46 +175,47 @@ static char * number(char * str, long num, int base, int size, int precision
 		else if (base == 8)
 			size--;
 	}
-	i = 0;
+	/* The digits are generated backwards from the end of tmp.  */
+	t = tmp + sizeof tmp;
 	if (num == 0)
-		tmp[i++]='0';
+		*--t = '0';
 	else while (num != 0)
-		tmp[i++] = digits[do_div(num,base)];
+		*--t = digits[do_div(num,base)];
+	i = tmp + sizeof tmp - t;
 	if (i > precision)
 		precision = i;
 	size -= precision;
-	if (!(type&(ZEROPAD+LEFT)))
-		while(size-->0)
-			*str++ = ' ';
+	if (!(type&(ZEROPAD+LEFT))) {
+		pad(out, ' ', size);
+		size = 0;
+	}
 	if (sign)
-		*str++ = sign;
-	if (type & SPECIAL)
+		emit(out, &sign, 1);
+	if (type & SPECIAL) {
 		if (base==8)
-			*str++ = '0';
-		else if (base==16) {
-			*str++ = '0';
-			*str++ = digits[33];
-		}
-	if (!(type & LEFT))
-		while (size-- > 0)
-			*str++ = c;
-	while (i < precision--)
-		*str++ = '0';
-	while (i-- > 0)
-		*str++ = tmp[i];
-	while (size-- > 0)
-		*str++ = ' ';
-	return str;
+			emit(out, "0", 1);
+		else if (base==16)
+			emit(out, (type & LARGE) ? "0X" : "0x", 2);
+	}
+	if (!(type & LEFT)) {
+		pad(out, c, size);
+		size = 0;
+	}
+	pad(out, '0', precision - i);
+	emit(out, t, i);
+	pad(out, ' ', size);
 }
 
-int vsprintf(char *buf, const char *fmt, va_list args)
+int _Vformat(void (*sink)(void *, const char *, size_t), void *cookie,
+	const char *fmt, va_list args)
 {
+	struct output out;
 	int len;
 	unsigned long num;
-	int i, base;
-	char * str;
-	char *s;
+	int base;
+	const char *s;
 #ifdef PRINT_FLOATS
+	char fbuf[16];
 	float fl;
 #endif /* PRINT_FLOATS */
 	int flags;		/* flags to number() */
@@ -193,9 +225,17 @@ int vsprintf(char *buf, const char *fmt, va_list args)
 				   number of chars for from string */
 	int qualifier;		/* 'h', 'l', or 'L' for integer fields */
 
-	for (str=buf ; *fmt ; ++fmt) {
+	out.sink = sink;
+	out.cookie = cookie;
+	out.count = 0;
+
+	while (*fmt) {
 		if (*fmt != '%') {
-			*str++ = *fmt;
+			/* Pass literal text on in runs, not a character at
+			   a time.  */
+			for (s = fmt; *fmt && *fmt != '%'; ++fmt)
+				/* nothing */;
+			emit(&out, s, fmt - s);
 			continue;
 		}
 			
@@ -250,15 +290,16 @@ int vsprintf(char *buf, const char *fmt, va_list args)
 		/* default base */
 		base = 10;
 
-		switch (*fmt) {
-		case 'c':
+		switch (*fmt++) {
+		case 'c': {
+			char c = (unsigned char) va_arg(args, int);
 			if (!(flags & LEFT))
-				while (--field_width > 0)
-					*str++ = ' ';
-			*str++ = (unsigned char) va_arg(args, int);
-			while (--field_width > 0)
-				*str++ = ' ';
+				pad(&out, ' ', field_width - 1);
+			emit(&out, &c, 1);
+			if (flags & LEFT)
+				pad(&out, ' ', field_width - 1);
 			continue;
+			}
 
 		case 's':
 			s = va_arg(args, char *);
@@ -268,12 +309,10 @@ int vsprintf(char *buf, const char *fmt, va_list args)
 			len = strnlen(s, precision);
 
 			if (!(flags & LEFT))
-				while (len < field_width--)
-					*str++ = ' ';
-			for (i = 0; i < len; ++i)
-				*str++ = *s++;
-			while (len < field_width--)
-				*str++ = ' ';
+				pad(&out, ' ', field_width - len);
+			emit(&out, s, len);
+			if (flags & LEFT)
+				pad(&out, ' ', field_width - len);
 			continue;
 
 		case 'p':
@@ -281,7 +320,7 @@ int vsprintf(char *buf, const char *fmt, va_list args)
 				field_width = 2*sizeof(void *);
 				flags |= ZEROPAD;
 			}
-			str = number(str,
+			number(&out,
 				(unsigned long) va_arg(args, void *), 16,
 				field_width, precision, flags);
 			continue;
@@ -289,17 +328,17 @@ int vsprintf(char *buf, const char *fmt, va_list args)
 #ifdef PRINT_FLOATS
                 case 'e':
 		        fl = va_arg(args, double);
-			str = ftoa(str,fl,flags);
+			emit(&out, fbuf, ftoa(fbuf,fl,flags) - fbuf);
                         continue;
 #endif /* PRINT_FLOATS */
 
 		case 'n':
 			if (qualifier == 'l') {
 				long * ip = va_arg(args, long *);
-				*ip = (str - buf);
+				*ip = out.count;
 			} else {
 				int * ip = va_arg(args, int *);
-				*ip = (str - buf);
+				*ip = out.count;
 			}
 			continue;
 
@@ -321,12 +360,11 @@ int vsprintf(char *buf, const char *fmt, va_list args)
 			break;
 
 		default:
+			--fmt;
 			if (*fmt != '%')
-				*str++ = '%';
+				emit(&out, "%", 1);
 			if (*fmt)
-				*str++ = *fmt;
-			else
-				--fmt;
+				emit(&out, fmt++, 1);
 			continue;
 		}
 		if (qualifier == 'l')
@@ -340,10 +378,56 @@ int vsprintf(char *buf, const char *fmt, va_list args)
 			num = va_arg(args, int);
 		else
 			num = va_arg(args, unsigned int);
-		str = number(str, num, base, field_width, precision, flags);
+		number(&out, num, base, field_width, precision, flags);
 	}
-	*str = '\0';
-	return str-buf;
+	return out.count;
+}
+
+/* Sink for vsnprintf: copy as much as fits, always leaving room for the
+ * terminating '\0', and quietly drop the rest.  */
+struct buffer {
+	char *str;
+	size_t room;
+};
+
+static void to_buffer(void *cookie, const char *s, size_t n)
+{
+	struct buffer *b = cookie;
+
+	if (n > b->room)
+		n = b->room;
+	memcpy(b->str, s, n);
+	b->str += n;
+	b->room -= n;
+}
+
+int vsnprintf(char *buf, size_t size, const char *fmt, va_list args)
+{
+	struct buffer b;
+	int i;
+
+	b.str = buf;
+	b.room = (size > 0) ? size - 1 : 0;
+	i = _Vformat(to_buffer, &b, fmt, args);
+	if (size > 0)
+		*b.str = '\0';
+	return i;
+}
+
+int snprintf(char *buf, size_t size, const char *fmt, ...)
+{
+	va_list args;
+	int i;
+
+	va_start(args, fmt);
+	i=vsnprintf(buf,size,fmt,args);
+	va_end(args);
+	return i;
+}
+
+int vsprintf(char *buf, const char *fmt, va_list args)
+{
+	return vsnprintf(buf, (size_t) -1, fmt, args);
 }
 
 int sprintf(char * buf, const char *fmt, ...)
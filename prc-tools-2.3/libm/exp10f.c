@@ -69,11 +69,11 @@ static float MAXL10 = 38.230809449325611792;
 extern float MAXNUMF;
 
 #ifdef ANSIC
-float floor(float), ldexp(float, int), polevl(float, float *, int);
+float floor(float), ldexp(float, int);
 
 float exp10(float xx)
 #else
-float floor(), ldexp(), polevl();
+float floor(), ldexp();
 
 float exp10(xx)
 double xx;
@@ -113,7 +113,7 @@ x -= qx * LG102B;
  * of the fractional part:
  * 10**x - 1  =  2x P(x**2)/( Q(x**2) - P(x**2) )
  */
-px = 1.0f + x * polevl( x, P, 5 );
+px = 1.0f + x * POLEVL5( x, P );
 
 /* multiply by power of 2 */
 x = ldexp( px, n );
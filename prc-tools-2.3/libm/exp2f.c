@@ -71,11 +71,11 @@ static float P[] = {
 extern float MAXNUMF;
 
 #ifdef ANSIC
-float polevl(float, float *, int), floor(float), ldexp(float, int);
+float floor(float), ldexp(float, int);
 
 float exp2( float xx )
 #else
-float polevl(), floor(), ldexp();
+float floor(), ldexp();
 
 float exp2(xx)
 double xx;
@@ -115,7 +115,7 @@ if( x > 0.5f )
 /* rational approximation
  * exp2(x) = 1.0 +  xP(x)
  */
-px = 1.0f + x * polevl( x, P, 5 );
+px = 1.0f + x * POLEVL5( x, P );
 
 /* scale by power of 2 */
 px = ldexp( px, i0 );
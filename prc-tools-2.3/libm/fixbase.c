@@ -0,0 +1,87 @@
+/* fixbase.c: fixed-point arithmetic for fixmath.h.
+
+   This code is in the public domain.  */
+
+#include "fixmath.h"
+
+/* The product is built from 16 by 16 bit partial products of the
+   magnitudes, which the 68000 can do with single mulu instructions, rather
+   than with a call to __mulsi3 or a 64 bit multiplication.  Only the low
+   half of the low partial product is lost, and it is used for rounding.  */
+fix16
+fix16_mul (fix16 a, fix16 b) {
+  uint32_t ua = (a < 0)? -(uint32_t) a : a;
+  uint32_t ub = (b < 0)? -(uint32_t) b : b;
+  uint16_t ah = ua >> 16, al = ua, bh = ub >> 16, bl = ub;
+  uint32_t r, t;
+  int overflow;
+
+  r = (uint32_t) ah * bh;
+  overflow = (r > 0x7fffUL);
+  r <<= 16;
+  t = (uint32_t) ah * bl;  r += t;  overflow |= (r < t);
+  t = (uint32_t) al * bh;  r += t;  overflow |= (r < t);
+  t = ((uint32_t) al * bl + 0x8000) >> 16;  r += t;  overflow |= (r < t);
+
+  if (overflow || r > 0x7fffffffUL)
+    return ((a ^ b) < 0)? FIX16_MIN : FIX16_MAX;
+  return ((a ^ b) < 0)? -(fix16) r : (fix16) r;
+  }
+
+fix16
+fix16_div (fix16 a, fix16 b) {
+  uint32_t ua = (a < 0)? -(uint32_t) a : a;
+  uint32_t ub = (b < 0)? -(uint32_t) b : b;
+  uint64_t q;
+
+  if (ub == 0)
+    return (a < 0)? FIX16_MIN : FIX16_MAX;
+
+  q = (((uint64_t) ua << 16) + (ub >> 1)) / ub;
+
+  if (q > 0x7fffffffUL)
+    return ((a ^ b) < 0)? FIX16_MIN : FIX16_MAX;
+  return ((a ^ b) < 0)? -(fix16) q : (fix16) q;
+  }
+
+/* Returns the rounded square root of V * 4^(N-16), found two bits at a time
+   from the top.  Once the bits of V have been used up, it is zero, so the
+   remaining N-16 pairs of bits are zeros.  This is shared with the
+   arcsine in fixtrig.c.  */
+uint32_t
+__fix_root (uint32_t v, int n) {
+  uint32_t rem = 0, r = 0;
+
+  for (; (v & 0xc0000000UL) == 0; v <<= 2)
+    n--;
+
+  while (n-- > 0) {
+    rem = (rem << 2) | (v >> 30);
+    v <<= 2;
+    r <<= 1;
+    if (rem >= 2 * r + 1) {
+      rem -= 2 * r + 1;
+      r++;
+      }
+    }
+
+  return (rem > r)? r + 1 : r;
+  }
+
+/* sqrt (x / 65536) * 65536 is the square root of x * 65536.  */
+fix16
+fix16_sqrt (fix16 x) {
+  return (x > 0)? (fix16) __fix_root (x, 24) : 0;
+  }
+
+fix15
+fix15_mul (fix15 a, fix15 b) {
+  int32_t r = ((int32_t) a * b + 0x4000) >> 15;
+  return (r > 0x7fff)? FIX15_MAX : r;
+  }
+
+/* Similarly, this is the square root of x * 32768.  */
+fix15
+fix15_sqrt (fix15 x) {
+  return (x > 0)? (fix15) __fix_root ((uint32_t) x << 15, 16) : 0;
+  }
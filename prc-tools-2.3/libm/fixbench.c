@@ -0,0 +1,185 @@
+/* fixbench.c: cycle counts for the fixed-point functions in libfixmath.a,
+   alongside those of the corresponding float functions in libmf.a.
+
+   This is a Palm OS application, built by the fixbench.prc target in
+   Makefile.in.  Run it on a device or the Emulator; for each function it
+   displays the average cycles per call of the fixed-point version and of
+   the float one, including the call overhead.  The processor clock is
+   measured as in libc/divbench.c.  The accuracy of the same functions is
+   checked on the host by fixmtst.c.
+
+   This code is in the public domain.  */
+
+#include <SystemMgr.h>
+#include <TimeMgr.h>
+#include <Window.h>
+#include <StringMgr.h>
+
+#include <NewTypes.h>
+
+#include "mathf.h"
+#include "fixmath.h"
+
+static void
+console (const char *text) {
+  static Int16 y = 0;
+  WinDrawChars (text, StrLen (text), 0, y);
+  y += 10;
+  }
+
+/* Each iteration of the dbra loop takes 10 cycles, and there are 65536
+   of them per call.  */
+static void
+spin (void) {
+  UInt16 n = 0xffff;
+  asm volatile ("1: dbra %0,1b" : "+d" (n));
+  }
+
+static UInt32 cycles_per_tick;
+
+static void
+calibrate (void) {
+  UInt32 start, ticks, n = 0;
+
+  start = TimGetTicks ();
+  do {
+    spin ();
+    n++;
+    ticks = TimGetTicks () - start;
+    } while (ticks < 2 * SysTicksPerSecond ());
+
+  cycles_per_tick = n * 655360UL / ticks;
+  }
+
+#define NOPERANDS  64
+
+static fix16 x[NOPERANDS], y[NOPERANDS];
+static float fx[NOPERANDS], fy[NOPERANDS];
+
+/* Results are stored here so that the operations aren't optimized away.  */
+static volatile fix16 sink;
+static volatile float fsink;
+
+static unsigned long seed = 1;
+
+static unsigned long
+random32 (void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+  }
+
+/* Operands are spread over [LO, LO + SPAN), in fix16 units.  */
+static void
+generate (fix16 lo, fix16 span) {
+  int i;
+
+  for (i = 0; i < NOPERANDS; i++) {
+    x[i] = lo + (fix16) (random32 () % span);
+    y[i] = lo + (fix16) (random32 () % span);
+    fx[i] = fix16_to_float (x[i]);
+    fy[i] = fix16_to_float (y[i]);
+    }
+  }
+
+enum { MUL, DIV, SQRT, SIN, TAN, ATAN2, ASIN, EXP, LOG, POW, TANH, NOPS };
+
+static const char *const op_name[] = {
+  "mul", "div", "sqrt", "sin", "tan", "atan2", "asin", "exp", "log", "pow",
+  "tanh"
+  };
+
+/* The operands for each function: LO and SPAN for generate.  */
+static const fix16 op_range[][2] = {
+  { -0x1000000L, 0x2000000L },		/* mul: -256..256 */
+  { -0x1000000L, 0x2000000L },		/* div */
+  { 0, 0x7fffffffL },			/* sqrt: 0..32768 */
+  { -0x60000L, 0xc0000L },		/* sin: -6..6 */
+  { -0x18000L, 0x30000L },		/* tan: -1.5..1.5 */
+  { -0x1000000L, 0x2000000L },		/* atan2 */
+  { -0x10000L, 0x20000L },		/* asin: -1..1 */
+  { -0xa0000L, 0x140000L },		/* exp: -10..10 */
+  { 1, 0x7fffffffL },			/* log: 0..32768 */
+  { 0x8000L, 0x78000L },		/* pow: 0.5..8, to powers 0.5..8 */
+  { -0x40000L, 0x80000L }		/* tanh: -4..4 */
+  };
+
+static void
+operate (int op, int fixed) {
+  int i;
+
+  if (fixed)
+    for (i = 0; i < NOPERANDS; i++)
+      switch (op) {
+      case MUL:    sink = fix16_mul (x[i], y[i]);  break;
+      case DIV:    sink = fix16_div (x[i], y[i]);  break;
+      case SQRT:   sink = fix16_sqrt (x[i]);  break;
+      case SIN:    sink = fix16_sin (x[i]);  break;
+      case TAN:    sink = fix16_tan (x[i]);  break;
+      case ATAN2:  sink = fix16_atan2 (y[i], x[i]);  break;
+      case ASIN:   sink = fix16_asin (x[i]);  break;
+      case EXP:    sink = fix16_exp (x[i]);  break;
+      case LOG:    sink = fix16_log (x[i]);  break;
+      case POW:    sink = fix16_pow (x[i], y[i]);  break;
+      case TANH:   sink = fix16_tanh (x[i]);  break;
+	}
+  else
+    for (i = 0; i < NOPERANDS; i++)
+      switch (op) {
+      case MUL:    fsink = fx[i] * fy[i];  break;
+      case DIV:    fsink = fx[i] / fy[i];  break;
+      case SQRT:   fsink = sqrt (fx[i]);  break;
+      case SIN:    fsink = sin (fx[i]);  break;
+      case TAN:    fsink = tan (fx[i]);  break;
+      case ATAN2:  fsink = atan2 (fy[i], fx[i]);  break;
+      case ASIN:   fsink = asin (fx[i]);  break;
+      case EXP:    fsink = exp (fx[i]);  break;
+      case LOG:    fsink = log (fx[i]);  break;
+      case POW:    fsink = pow (fx[i], fy[i]);  break;
+      case TANH:   fsink = tanh (fx[i]);  break;
+	}
+  }
+
+/* Average cycles per operation, including the loop overhead.  */
+static UInt32
+measure (int op, int fixed) {
+  UInt32 start, ticks, calls = 0;
+
+  start = TimGetTicks ();
+  do {
+    operate (op, fixed);
+    calls += NOPERANDS;
+    ticks = TimGetTicks () - start;
+    } while (ticks < SysTicksPerSecond () / 2);
+
+  return ticks * cycles_per_tick / calls;
+  }
+
+UInt32
+PilotMain (UInt16 cmd, void *cmdPBP __attribute__ ((unused)),
+	   UInt16 launchFlags __attribute__ ((unused))) {
+  if (cmd == sysAppLaunchCmdNormalLaunch) {
+    char line[80];
+    int op;
+
+    calibrate ();
+    StrPrintF (line, "%lu cycles/tick", cycles_per_tick);
+    console (line);
+    console ("Columns: fix16 float");
+
+    for (op = MUL; op < NOPS; op++) {
+      UInt32 fixed, flt;
+
+      generate (op_range[op][0], op_range[op][1]);
+      fixed = measure (op, 1);
+      flt = measure (op, 0);
+      StrPrintF (line, "%s: %lu %lu", op_name[op], fixed, flt);
+      console (line);
+      }
+
+    SysTaskDelay (30 * SysTicksPerSecond ());
+    }
+
+  return 0;
+  }
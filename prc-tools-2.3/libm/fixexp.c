@@ -0,0 +1,230 @@
+/* fixexp.c: fixed-point exponential and logarithmic functions for
+   fixmath.h.
+
+   Everything is done in base 2: the fractional part of an exponent is
+   interpolated linearly in a table of 2^f, and the mantissa of a logarithm
+   is normalized to [1,2) and interpolated in a table of log2.  The tables
+   were generated with a double precision libm, rounding to nearest.
+
+   This code is in the public domain.  */
+
+#include "fixmath.h"
+
+/* Conversion factors between bases, with 30 fractional bits.  */
+#define LOG2E	0x5c551d95UL
+#define LOG2_10	0xd49a784cUL
+#define LN2	0x2c5c85feUL
+#define LOG10_2	0x13441351UL
+
+#define FIX16_LN2  ((fix16) 45426L)
+
+/* Returns X times K / 2^30, rounded, saturating.  The 64 bit product is
+   assembled from 16 by 16 bit partial products, and its low half is only
+   needed for the carries.  */
+static fix16
+scale (fix16 x, uint32_t k) {
+  uint32_t ux = (x < 0)? -(uint32_t) x : x;
+  uint16_t xh = ux >> 16, xl = ux, kh = k >> 16, kl = k;
+  uint32_t hi = (uint32_t) xh * kh, lo = (uint32_t) xl * kl;
+  uint32_t m1 = (uint32_t) xh * kl, m2 = (uint32_t) xl * kh, t;
+  fix16 r;
+
+  hi += (m1 >> 16) + (m2 >> 16);
+  t = lo + (m1 << 16);  hi += (t < lo);  lo = t;
+  t = lo + (m2 << 16);  hi += (t < lo);  lo = t;
+  t = lo + 0x20000000UL;  hi += (t < lo);  lo = t;
+
+  if (hi >= 0x20000000UL)
+    return (x < 0)? FIX16_MIN : FIX16_MAX;
+
+  r = (hi << 2) | (lo >> 30);
+  return (x < 0)? -r : r;
+  }
+
+/* 65536 (2^(k / 256) - 1).  */
+static const uint16_t exp2_table[256] = {
+  0, 178, 356, 535, 714, 893, 1073, 1254, 1435, 1617, 1799, 1981, 2164,
+  2348, 2532, 2716, 2902, 3087, 3273, 3460, 3647, 3834, 4022, 4211,
+  4400, 4590, 4780, 4971, 5162, 5353, 5546, 5738, 5932, 6125, 6320,
+  6514, 6710, 6906, 7102, 7299, 7496, 7694, 7893, 8092, 8292, 8492,
+  8693, 8894, 9096, 9298, 9501, 9704, 9908, 10113, 10318, 10524, 10730,
+  10937, 11144, 11352, 11560, 11769, 11979, 12189, 12400, 12611, 12823,
+  13036, 13249, 13462, 13676, 13891, 14106, 14322, 14539, 14756, 14974,
+  15192, 15411, 15630, 15850, 16071, 16292, 16514, 16737, 16960, 17183,
+  17408, 17633, 17858, 18084, 18311, 18538, 18766, 18995, 19224, 19454,
+  19684, 19915, 20147, 20379, 20612, 20846, 21080, 21315, 21550, 21786,
+  22023, 22260, 22498, 22737, 22977, 23216, 23457, 23698, 23940, 24183,
+  24426, 24670, 24915, 25160, 25406, 25652, 25900, 26148, 26396, 26645,
+  26895, 27146, 27397, 27649, 27902, 28155, 28409, 28664, 28919, 29175,
+  29432, 29690, 29948, 30207, 30466, 30727, 30988, 31249, 31512, 31775,
+  32039, 32303, 32568, 32834, 33101, 33369, 33637, 33906, 34175, 34446,
+  34717, 34988, 35261, 35534, 35808, 36083, 36359, 36635, 36912, 37190,
+  37468, 37747, 38028, 38308, 38590, 38872, 39155, 39439, 39724, 40009,
+  40295, 40582, 40870, 41158, 41448, 41738, 42029, 42320, 42613, 42906,
+  43200, 43495, 43790, 44087, 44384, 44682, 44981, 45280, 45581, 45882,
+  46184, 46487, 46791, 47095, 47401, 47707, 48014, 48322, 48631, 48940,
+  49251, 49562, 49874, 50187, 50500, 50815, 51131, 51447, 51764, 52082,
+  52401, 52721, 53041, 53363, 53685, 54008, 54333, 54658, 54983, 55310,
+  55638, 55966, 56296, 56626, 56957, 57289, 57622, 57956, 58291, 58627,
+  58964, 59301, 59640, 59979, 60319, 60661, 61003, 61346, 61690, 62035,
+  62381, 62727, 63075, 63424, 63774, 64124, 64476, 64828, 65182
+  };
+fix16
+fix16_exp2 (fix16 x) {
+  int16_t n = x >> 16;
+  uint16_t i = (x >> 8) & 0xff, f = x & 0xff;
+  uint16_t y0 = exp2_table[i];
+  uint16_t d = (i < 255)? exp2_table[i + 1] - y0 : 0x10000L - y0;
+  uint32_t m = 0x10000UL + y0 + (((uint32_t) d * f + 0x80) >> 8);
+
+  /* M is 2^(x - n), in [1,2].  */
+  if (n >= 15)
+    return FIX16_MAX;
+  else if (n >= 0)
+    return m << n;
+  else if (n >= -17)
+    return (m + (1UL << (-n - 1))) >> -n;
+  else
+    return 0;
+  }
+
+fix16
+fix16_exp (fix16 x) {
+  return fix16_exp2 (scale (x, LOG2E));
+  }
+
+fix16
+fix16_exp10 (fix16 x) {
+  return fix16_exp2 (scale (x, LOG2_10));
+  }
+
+/* 65536 log2 (1 + k / 256).  */
+static const uint16_t log2_table[256] = {
+  0, 369, 736, 1102, 1466, 1829, 2190, 2551, 2909, 3267, 3623, 3978,
+  4331, 4683, 5034, 5384, 5732, 6079, 6425, 6769, 7112, 7454, 7795,
+  8134, 8473, 8810, 9146, 9480, 9814, 10146, 10477, 10807, 11136, 11464,
+  11791, 12116, 12440, 12764, 13086, 13407, 13727, 14046, 14363, 14680,
+  14996, 15310, 15624, 15937, 16248, 16559, 16868, 17177, 17484, 17791,
+  18096, 18401, 18704, 19007, 19308, 19609, 19909, 20207, 20505, 20802,
+  21098, 21393, 21687, 21980, 22272, 22564, 22854, 23144, 23433, 23720,
+  24007, 24293, 24579, 24863, 25146, 25429, 25711, 25992, 26272, 26551,
+  26830, 27108, 27384, 27660, 27936, 28210, 28484, 28757, 29029, 29300,
+  29571, 29840, 30109, 30378, 30645, 30912, 31178, 31443, 31707, 31971,
+  32234, 32496, 32758, 33019, 33279, 33538, 33797, 34055, 34312, 34569,
+  34825, 35080, 35334, 35588, 35841, 36094, 36346, 36597, 36847, 37097,
+  37346, 37595, 37842, 38090, 38336, 38582, 38827, 39072, 39316, 39559,
+  39802, 40044, 40286, 40527, 40767, 41006, 41246, 41484, 41722, 41959,
+  42196, 42432, 42667, 42902, 43137, 43370, 43603, 43836, 44068, 44300,
+  44530, 44761, 44990, 45220, 45448, 45676, 45904, 46131, 46357, 46583,
+  46809, 47034, 47258, 47482, 47705, 47928, 48150, 48372, 48593, 48813,
+  49034, 49253, 49472, 49691, 49909, 50127, 50344, 50560, 50776, 50992,
+  51207, 51422, 51636, 51850, 52063, 52276, 52488, 52700, 52911, 53122,
+  53332, 53542, 53751, 53960, 54169, 54377, 54584, 54791, 54998, 55204,
+  55410, 55615, 55820, 56025, 56229, 56432, 56635, 56838, 57040, 57242,
+  57443, 57644, 57845, 58045, 58245, 58444, 58643, 58841, 59039, 59237,
+  59434, 59631, 59827, 60023, 60219, 60414, 60609, 60803, 60997, 61190,
+  61384, 61576, 61769, 61961, 62152, 62343, 62534, 62725, 62915, 63104,
+  63294, 63483, 63671, 63859, 64047, 64234, 64421, 64608, 64794, 64980,
+  65166, 65351
+  };
+fix16
+fix16_log2 (fix16 x) {
+  uint32_t m = x;
+  int16_t e = 14;
+  uint16_t i, f, y0, d;
+
+  if (x <= 0)
+    return FIX16_MIN;
+
+  /* Normalize so that bit 30 is the leading one, when M / 2^30 is in [1,2)
+     and x / 65536 is M / 2^30 * 2^E.  */
+  if (m < 0x4000UL) {
+    m <<= 16;
+    e -= 16;
+    }
+  if (m < 0x400000UL) {
+    m <<= 8;
+    e -= 8;
+    }
+  while (m < 0x40000000UL) {
+    m <<= 1;
+    e--;
+    }
+
+  i = (m >> 22) & 0xff;
+  f = m >> 6;
+  y0 = log2_table[i];
+  d = (i < 255)? log2_table[i + 1] - y0 : 0x10000L - y0;
+  return ((fix16) e << 16) + y0 + (((uint32_t) d * f + 0x8000) >> 16);
+  }
+
+fix16
+fix16_log (fix16 x) {
+  return (x > 0)? scale (fix16_log2 (x), LN2) : FIX16_MIN;
+  }
+
+fix16
+fix16_log10 (fix16 x) {
+  return (x > 0)? scale (fix16_log2 (x), LOG10_2) : FIX16_MIN;
+  }
+
+fix16
+fix16_pow (fix16 x, fix16 y) {
+  fix16 r;
+
+  if (x > 0)
+    return fix16_exp2 (fix16_mul (y, fix16_log2 (x)));
+  else if (x == 0)
+    return (y > 0)? 0 : FIX16_MAX;
+  else if (y & 0xffff)
+    return 0;
+
+  r = fix16_exp2 (fix16_mul (y, fix16_log2 (-x)));
+  return (y & 0x10000L)? -r : r;
+  }
+
+/* The hyperbolic functions are built from e^(|x| - ln 2) and e^(-|x| - ln 2),
+   which are halves of e^|x| and e^-|x|, so that sinh and cosh only overflow
+   when their results do.  Beyond 12, they overflow anyway.  */
+
+fix16
+fix16_sinh (fix16 x) {
+  uint32_t ax = (x < 0)? -(uint32_t) x : x;
+  fix16 r;
+
+  if (ax >= 0xc0000UL)
+    r = FIX16_MAX;
+  else
+    r = fix16_exp ((fix16) ax - FIX16_LN2) - fix16_exp (-(fix16) ax - FIX16_LN2);
+
+  return (x < 0)? -r : r;
+  }
+
+fix16
+fix16_cosh (fix16 x) {
+  uint32_t ax = (x < 0)? -(uint32_t) x : x;
+  fix16 a, b;
+
+  if (ax >= 0xc0000UL)
+    return FIX16_MAX;
+
+  a = fix16_exp ((fix16) ax - FIX16_LN2);
+  b = fix16_exp (-(fix16) ax - FIX16_LN2);
+  return (a > FIX16_MAX - b)? FIX16_MAX : a + b;
+  }
+
+/* tanh (x) = (1 - e^-2|x|) / (1 + e^-2|x|), which rounds to 1 beyond 7.  */
+fix16
+fix16_tanh (fix16 x) {
+  uint32_t ax = (x < 0)? -(uint32_t) x : x;
+  fix16 r;
+
+  if (ax >= 0x70000UL)
+    r = FIX16_ONE;
+  else {
+    fix16 t = fix16_exp (-2 * (fix16) ax);
+    r = fix16_div (FIX16_ONE - t, FIX16_ONE + t);
+    }
+
+  return (x < 0)? -r : r;
+  }
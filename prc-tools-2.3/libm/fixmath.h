@@ -0,0 +1,118 @@
+/* fixmath.h: fixed-point mathematical functions.
+
+   On processors without floating point hardware, even the single
+   precision functions in libmf spend most of their time in the software
+   floating point routines.  These functions, in libfixmath.a, work with
+   fixed-point numbers instead, and are several times faster, at the cost
+   of range and relative precision.
+
+   A fix16 is a Q16.16 number: a 32 bit integer holding 65536 times the
+   value, so that it can represent values from -32768 to just under 32768
+   in steps of 1/65536.  A fix15 is a Q1.15 number: a 16 bit integer
+   holding 32768 times the value, from -1 to just under 1.  Angles are in
+   radians for the fix16 functions, and in half turns for the fix15 ones,
+   so that the whole range of a fix15 covers the circle once.
+
+   Results that are too large saturate to FIX16_MAX or FIX16_MIN, and
+   results outside a function's domain are as described below; errno is
+   not set.  The trigonometric, exponential and logarithmic functions are
+   table-driven, and are accurate to within a few units in the last place,
+   or for the exponential functions, to within 3e-5 of the result; tan is
+   found as sin / cos, so its relative error grows as 1 / |cos x| near its
+   poles.  fixmtst.c checks these bounds.
+
+   This code is in the public domain.  */
+
+#ifndef _FIXMATH_H
+#define _FIXMATH_H
+
+#include <stdint.h>
+
+typedef int32_t fix16;
+typedef int16_t fix15;
+
+#define FIX16_ONE	((fix16) 0x10000L)
+#define FIX16_MAX	((fix16) 0x7fffffffL)
+#define FIX16_MIN	((fix16) (-0x7fffffffL - 1))
+
+#define FIX16_PI	((fix16) 205887L)
+#define FIX16_PI_2	((fix16) 102944L)
+#define FIX16_E		((fix16) 178145L)
+
+#define FIX15_MAX	((fix15) 0x7fff)
+#define FIX15_MIN	((fix15) -0x8000)
+
+/* Conversions.  Converting to an integer or a fix15 rounds to nearest;
+   converting from a float or double rounds to nearest, and doesn't
+   saturate.  */
+
+#define fix16_from_int(n)	((fix16) (n) << 16)
+#define fix16_to_int(x)		((int) (((x) + 0x8000L) >> 16))
+#define fix16_from_float(f)	((fix16) ((f) >= 0 ? (f) * 65536.0 + 0.5 \
+						       : (f) * 65536.0 - 0.5))
+#define fix16_to_float(x)	((float) (x) / 65536.0f)
+
+#define fix16_from_fix15(x)	((fix16) (x) << 1)
+#define fix16_to_fix15(x)	((fix15) ((x) >= 0xffffL ? 0x7fff \
+					  : (x) < -0x10000L ? -0x8000 \
+					  : ((x) + 1) >> 1))
+
+#define fix16_abs(x)		((x) < 0 ? -(x) : (x))
+#define fix16_floor(x)		((x) & ~0xffffL)
+#define fix16_ceil(x)		(((x) + 0xffffL) & ~0xffffL)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Arithmetic.  Products and quotients are rounded to nearest; division by
+   zero gives FIX16_MAX or FIX16_MIN according to the dividend's sign, and
+   the square root of a negative number is 0.  */
+
+fix16 fix16_mul (fix16 a, fix16 b);
+fix16 fix16_div (fix16 a, fix16 b);
+fix16 fix16_sqrt (fix16 x);
+
+/* Trigonometric functions.  asin and acos clamp their argument to [-1,1];
+   atan2 (0, 0) is 0.  */
+
+fix16 fix16_sin (fix16 x);
+fix16 fix16_cos (fix16 x);
+void fix16_sincos (fix16 x, fix16 *sinp, fix16 *cosp);
+fix16 fix16_tan (fix16 x);
+fix16 fix16_asin (fix16 x);
+fix16 fix16_acos (fix16 x);
+fix16 fix16_atan (fix16 x);
+fix16 fix16_atan2 (fix16 y, fix16 x);
+
+/* Exponential and logarithmic functions.  The logarithm of zero or a
+   negative number is FIX16_MIN; pow (x, y) for negative x is defined only
+   for integral y, and is 0 otherwise.  */
+
+fix16 fix16_exp (fix16 x);
+fix16 fix16_exp2 (fix16 x);
+fix16 fix16_exp10 (fix16 x);
+fix16 fix16_log (fix16 x);
+fix16 fix16_log2 (fix16 x);
+fix16 fix16_log10 (fix16 x);
+fix16 fix16_pow (fix16 x, fix16 y);
+fix16 fix16_sinh (fix16 x);
+fix16 fix16_cosh (fix16 x);
+fix16 fix16_tanh (fix16 x);
+
+/* Q1.15 functions.  The angles for sin and cos, and the result of atan2,
+   are in half turns, so that FIX15_MIN is -pi; atan2 takes any pair of
+   16 bit integers with the same scale, and sqrt of a negative number is
+   0.  sin and cos of a quarter turn are FIX15_MAX.  */
+
+fix15 fix15_mul (fix15 a, fix15 b);
+fix15 fix15_sqrt (fix15 x);
+fix15 fix15_sin (fix15 a);
+fix15 fix15_cos (fix15 a);
+fix15 fix15_atan2 (fix15 y, fix15 x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,273 @@
+/* Host-side accuracy tests for the fixed-point functions in fixmath.h.
+
+   This is built with the host's compiler (see the fixmtst target in
+   Makefile.in), and each function is compared with the host's double
+   precision libm, evaluated at exactly the same fixed-point argument, over
+   sweeps of its domain and random arguments.  The maximum error is
+   reported in units of the last place, and separately relative to the
+   result for the functions whose results can be large.  The test fails if
+   any function exceeds the bounds given in its table entry below.
+
+   The fixed-point code uses only the types from <stdint.h>, so it behaves
+   the same here as on the 68000.  For cycle counts on the device, see
+   fixbench.c.
+
+   This code is in the public domain.  */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "fixbase.c"
+#include "fixtrig.c"
+#include "fixexp.c"
+
+static unsigned long seed = 1;
+
+static uint32_t
+random32 (void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+  }
+
+static double
+to_double (fix16 x) {
+  return x / 65536.0;
+  }
+
+/* Uniformly distributed in [lo, hi).  */
+static fix16
+random_in (double lo, double hi) {
+  return (fix16) floor ((lo + (hi - lo) * (random32 () / 4294967296.0))
+			* 65536.0);
+  }
+
+struct test {
+  const char *name;
+  double lo, hi;		/* Domain of the first argument.  */
+  double lo2, hi2;		/* And of the second, if any.  */
+  double ulps, rel;		/* Allowed error: ULPS + REL * |result|.  */
+  double (*ref) (double x, double y);
+  fix16 (*fn) (fix16 x, fix16 y);
+  double scale;			/* 65536 for fix16 results, etc.  */
+  };
+
+/* Adaptors to the common signatures.  */
+
+static double r_mul (double x, double y) { return x * y; }
+static double r_div (double x, double y) { return x / y; }
+static double r_sqrt (double x, double y) { return sqrt (x); }
+static double r_sin (double x, double y) { return sin (x); }
+static double r_cos (double x, double y) { return cos (x); }
+static double r_tan (double x, double y) { return tan (x); }
+static double r_asin (double x, double y) { return asin (x); }
+static double r_acos (double x, double y) { return acos (x); }
+static double r_atan (double x, double y) { return atan (x); }
+static double r_atan2 (double x, double y) { return atan2 (x, y); }
+static double r_exp (double x, double y) { return exp (x); }
+static double r_exp2 (double x, double y) { return exp2 (x); }
+static double r_exp10 (double x, double y) { return pow (10.0, x); }
+static double r_log (double x, double y) { return log (x); }
+static double r_log2 (double x, double y) { return log2 (x); }
+static double r_log10 (double x, double y) { return log10 (x); }
+static double r_pow (double x, double y) { return pow (x, y); }
+static double r_sinh (double x, double y) { return sinh (x); }
+static double r_cosh (double x, double y) { return cosh (x); }
+static double r_tanh (double x, double y) { return tanh (x); }
+
+static fix16 f_sqrt (fix16 x, fix16 y) { return fix16_sqrt (x); }
+static fix16 f_sin (fix16 x, fix16 y) { return fix16_sin (x); }
+static fix16 f_cos (fix16 x, fix16 y) { return fix16_cos (x); }
+static fix16 f_tan (fix16 x, fix16 y) { return fix16_tan (x); }
+static fix16 f_asin (fix16 x, fix16 y) { return fix16_asin (x); }
+static fix16 f_acos (fix16 x, fix16 y) { return fix16_acos (x); }
+static fix16 f_atan (fix16 x, fix16 y) { return fix16_atan (x); }
+static fix16 f_exp (fix16 x, fix16 y) { return fix16_exp (x); }
+static fix16 f_exp2 (fix16 x, fix16 y) { return fix16_exp2 (x); }
+static fix16 f_exp10 (fix16 x, fix16 y) { return fix16_exp10 (x); }
+static fix16 f_log (fix16 x, fix16 y) { return fix16_log (x); }
+static fix16 f_log2 (fix16 x, fix16 y) { return fix16_log2 (x); }
+static fix16 f_log10 (fix16 x, fix16 y) { return fix16_log10 (x); }
+static fix16 f_sinh (fix16 x, fix16 y) { return fix16_sinh (x); }
+static fix16 f_cosh (fix16 x, fix16 y) { return fix16_cosh (x); }
+static fix16 f_tanh (fix16 x, fix16 y) { return fix16_tanh (x); }
+
+/* The Q1.15 functions, with their arguments and results as fix16s.  */
+static fix16 f15_mul (fix16 x, fix16 y)
+  { return fix15_mul (x >> 1, y >> 1) * 2L; }
+static fix16 f15_sqrt (fix16 x, fix16 y)
+  { return fix15_sqrt (x >> 1) * 2L; }
+static fix16 f15_sin (fix16 x, fix16 y)
+  { return fix15_sin (x >> 1) * 2L; }
+static fix16 f15_cos (fix16 x, fix16 y)
+  { return fix15_cos (x >> 1) * 2L; }
+static fix16 f15_atan2 (fix16 x, fix16 y)
+  { return fix15_atan2 (x >> 1, y >> 1) * 2L; }
+
+static double r15_mul (double x, double y)
+  { double r = x * y; return (r >= 32767 / 32768.0)? 32767 / 32768.0 : r; }
+static double r15_sin (double x, double y) { return sin (M_PI * x); }
+static double r15_cos (double x, double y) { return cos (M_PI * x); }
+static double r15_atan2 (double x, double y)
+  { double r = atan2 (x, y) / M_PI; return (r >= 1.0)? -1.0 : r; }
+
+/* The Q1.15 arguments are made even, so that x >> 1 loses nothing; their
+   results are all compared with 1/32768 as the unit in the last place.  */
+
+static const struct test tests[] = {
+  { "mul", -181, 181, -181, 181, 0.5, 0, r_mul, fix16_mul, 65536 },
+  { "div", -32768, 32768, -8, 8, 0.5, 0, r_div, fix16_div, 65536 },
+  { "sqrt", 0, 32768, 0, 0, 0.5, 0, r_sqrt, f_sqrt, 65536 },
+  { "sin", -32, 32, 0, 0, 1.5, 0, r_sin, f_sin, 65536 },
+  { "cos", -32, 32, 0, 0, 1.5, 0, r_cos, f_cos, 65536 },
+  { "tan", -1.4, 1.4, 0, 0, 2, 1.5e-4, r_tan, f_tan, 65536 },
+  { "asin", -1, 1, 0, 0, 3, 0, r_asin, f_asin, 65536 },
+  { "acos", -1, 1, 0, 0, 3, 0, r_acos, f_acos, 65536 },
+  { "atan", -32768, 32768, 0, 0, 3, 0, r_atan, f_atan, 65536 },
+  { "atan2", -32768, 32768, -32768, 32768, 3, 0,
+    r_atan2, fix16_atan2, 65536 },
+  { "exp", -12, 10.39, 0, 0, 1, 3e-5, r_exp, f_exp, 65536 },
+  { "exp2", -18, 14.99, 0, 0, 1, 3e-5, r_exp2, f_exp2, 65536 },
+  { "exp10", -5, 4.51, 0, 0, 1, 3e-5, r_exp10, f_exp10, 65536 },
+  { "log", 0.0001, 32768, 0, 0, 1.5, 0, r_log, f_log, 65536 },
+  { "log2", 0.0001, 32768, 0, 0, 1.5, 0, r_log2, f_log2, 65536 },
+  { "log10", 0.0001, 32768, 0, 0, 1.5, 0, r_log10, f_log10, 65536 },
+  { "pow", 0.5, 16, -3, 3, 2, 1e-4, r_pow, fix16_pow, 65536 },
+  { "sinh", -11, 11, 0, 0, 1.5, 3e-5, r_sinh, f_sinh, 65536 },
+  { "cosh", -11, 11, 0, 0, 1.5, 3e-5, r_cosh, f_cosh, 65536 },
+  { "tanh", -8, 8, 0, 0, 1.5, 0, r_tanh, f_tanh, 65536 },
+  { "fix15_mul", -1, 1, -1, 1, 0.5, 0, r15_mul, f15_mul, 32768 },
+  { "fix15_sqrt", 0, 1, 0, 0, 0.5, 0, r_sqrt, f15_sqrt, 32768 },
+  { "fix15_sin", -1, 1, 0, 0, 1.25, 0, r15_sin, f15_sin, 32768 },
+  { "fix15_cos", -1, 1, 0, 0, 1.25, 0, r15_cos, f15_cos, 32768 },
+  { "fix15_atan2", -1, 1, -1, 1, 1, 0, r15_atan2, f15_atan2, 32768 },
+  };
+
+#define NTESTS	(sizeof tests / sizeof tests[0])
+
+#define NSWEEP	200000
+#define NRANDOM	1000000
+
+static int
+run (const struct test *t) {
+  double max_ulps = 0, max_rel = 0, worst_x = 0, worst_y = 0;
+  int fix15 = (t->scale != 65536), ok = 1;
+  long i;
+
+  for (i = 0; i < NSWEEP + NRANDOM; i++) {
+    fix16 x, y = 0;
+    double ref, got, err, rel;
+
+    if (i < NSWEEP)
+      x = (fix16) floor ((t->lo + (t->hi - t->lo) * i / NSWEEP) * 65536.0);
+    else
+      x = random_in (t->lo, t->hi);
+    if (t->lo2 != t->hi2)
+      y = random_in (t->lo2, t->hi2);
+    if (fix15) {
+      x &= ~1L;
+      y &= ~1L;
+      }
+
+    ref = t->ref (to_double (x), to_double (y));
+    got = t->fn (x, y) / 65536.0;
+    /* Half turns of -1 and 1 are the same angle.  */
+    if (t->ref == r15_atan2 && fabs (got - ref) > 1.0)
+      got += (got < ref)? 2.0 : -2.0;
+    if (fix15 && got > 1.0 && ref >= 1.0)
+      got = ref = 32767 / 32768.0;
+
+    /* Results that overflow are expected to saturate.  */
+    if (isnan (ref) || fabs (ref) >= 32768.0 || (t->fn == fix16_div && y == 0))
+      continue;
+
+    err = fabs (got - ref) * t->scale;
+    rel = (ref != 0)? fabs (got - ref) / fabs (ref) : 0;
+    if (err > t->ulps + t->rel * fabs (ref) * t->scale) {
+      if (ok)
+	printf ("%s (%.6f, %.6f) = %.6f, should be %.6f\n",
+		t->name, to_double (x), to_double (y), got, ref);
+      ok = 0;
+      }
+    if (err > max_ulps) {
+      max_ulps = err;
+      worst_x = to_double (x);
+      worst_y = to_double (y);
+      }
+    if (fabs (ref) >= 1.0 && rel > max_rel)
+      max_rel = rel;
+    }
+
+  printf ("%-12s max %.3f ulps at (%g, %g), max relative %.2e  %s\n",
+	  t->name, max_ulps, worst_x, worst_y, max_rel, ok? "ok" : "FAILED");
+  return ok;
+  }
+
+/* The saturating edge cases, which the sweeps skip.  */
+static int
+edges (void) {
+  static const struct { const char *expr; fix16 want; } e[] = {
+    { "mul (MAX, 2)", FIX16_MAX },
+    { "mul (MIN, 2)", FIX16_MIN },
+    { "div (1, 0)", FIX16_MAX },
+    { "div (-1, 0)", FIX16_MIN },
+    { "sqrt (-1)", 0 },
+    { "log (0)", FIX16_MIN },
+    { "exp (11)", FIX16_MAX },
+    { "exp (-12)", 0 },
+    { "pow (-2, 3)", fix16_from_int (-8) },
+    { "pow (-2, 0.5)", 0 },
+    { "pow (0, -1)", FIX16_MAX },
+    { "sinh (-20)", FIX16_MIN + 1 },
+    { "cosh (MIN)", FIX16_MAX },
+    { "tanh (MIN)", -FIX16_ONE },
+    { "atan2 (0, 0)", 0 },
+    { "atan2 (0, -1)", FIX16_PI },
+    };
+  fix16 got[sizeof e / sizeof e[0]];
+  unsigned i;
+  int ok = 1;
+
+  got[0] = fix16_mul (FIX16_MAX, fix16_from_int (2));
+  got[1] = fix16_mul (FIX16_MIN, fix16_from_int (2));
+  got[2] = fix16_div (FIX16_ONE, 0);
+  got[3] = fix16_div (-FIX16_ONE, 0);
+  got[4] = fix16_sqrt (-FIX16_ONE);
+  got[5] = fix16_log (0);
+  got[6] = fix16_exp (fix16_from_int (11));
+  got[7] = fix16_exp (fix16_from_int (-12));
+  got[8] = fix16_pow (fix16_from_int (-2), fix16_from_int (3));
+  got[9] = fix16_pow (fix16_from_int (-2), FIX16_ONE / 2);
+  got[10] = fix16_pow (0, -FIX16_ONE);
+  got[11] = fix16_sinh (fix16_from_int (-20));
+  got[12] = fix16_cosh (FIX16_MIN);
+  got[13] = fix16_tanh (FIX16_MIN);
+  got[14] = fix16_atan2 (0, 0);
+  got[15] = fix16_atan2 (0, -FIX16_ONE);
+
+  for (i = 0; i < sizeof e / sizeof e[0]; i++)
+    if (got[i] != e[i].want) {
+      printf ("%s = %ld, should be %ld\n", e[i].expr,
+	      (long) got[i], (long) e[i].want);
+      ok = 0;
+      }
+
+  printf ("%-12s %s\n", "edge cases", ok? "ok" : "FAILED");
+  return ok;
+  }
+
+int
+main (void) {
+  unsigned i;
+  int ok = 1;
+
+  for (i = 0; i < NTESTS; i++)
+    if (! run (&tests[i]))
+      ok = 0;
+
+  if (! edges ())
+    ok = 0;
+
+  return ok? 0 : 1;
+  }
@@ -0,0 +1,241 @@
+/* fixtrig.c: fixed-point trigonometric functions for fixmath.h.
+
+   Sine and cosine are interpolated linearly in a quarter wave table after
+   the angle has been reduced to a fraction of a turn, and the arctangent
+   in a table over [0,1] after reduction to the first octant.  The tables
+   were generated with a double precision libm, rounding to nearest.
+
+   This code is in the public domain.  */
+
+#include "fixmath.h"
+
+extern uint32_t __fix_root (uint32_t v, int n);
+
+/* 65536 sin (k pi / 512), for the first quadrant.  */
+static const uint16_t sin_table[256] = {
+  0, 402, 804, 1206, 1608, 2010, 2412, 2814, 3216, 3617, 4019, 4420,
+  4821, 5222, 5623, 6023, 6424, 6824, 7224, 7623, 8022, 8421, 8820,
+  9218, 9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391, 12785,
+  13180, 13573, 13966, 14359, 14751, 15143, 15534, 15924, 16314, 16703,
+  17091, 17479, 17867, 18253, 18639, 19024, 19409, 19792, 20175, 20557,
+  20939, 21320, 21699, 22078, 22457, 22834, 23210, 23586, 23961, 24335,
+  24708, 25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656, 28020,
+  28383, 28745, 29106, 29466, 29824, 30182, 30538, 30893, 31248, 31600,
+  31952, 32303, 32652, 33000, 33347, 33692, 34037, 34380, 34721, 35062,
+  35401, 35738, 36075, 36410, 36744, 37076, 37407, 37736, 38064, 38391,
+  38716, 39040, 39362, 39683, 40002, 40320, 40636, 40951, 41264, 41576,
+  41886, 42194, 42501, 42806, 43110, 43412, 43713, 44011, 44308, 44604,
+  44898, 45190, 45480, 45769, 46056, 46341, 46624, 46906, 47186, 47464,
+  47741, 48015, 48288, 48559, 48828, 49095, 49361, 49624, 49886, 50146,
+  50404, 50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398, 52639,
+  52878, 53114, 53349, 53581, 53812, 54040, 54267, 54491, 54714, 54934,
+  55152, 55368, 55582, 55794, 56004, 56212, 56418, 56621, 56823, 57022,
+  57219, 57414, 57607, 57798, 57986, 58172, 58356, 58538, 58718, 58896,
+  59071, 59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392, 60547,
+  60700, 60851, 60999, 61145, 61288, 61429, 61568, 61705, 61839, 61971,
+  62101, 62228, 62353, 62476, 62596, 62714, 62830, 62943, 63054, 63162,
+  63268, 63372, 63473, 63572, 63668, 63763, 63854, 63944, 64031, 64115,
+  64197, 64277, 64354, 64429, 64501, 64571, 64639, 64704, 64766, 64827,
+  64884, 64940, 64993, 65043, 65091, 65137, 65180, 65220, 65259, 65294,
+  65328, 65358, 65387, 65413, 65436, 65457, 65476, 65492, 65505, 65516,
+  65525, 65531, 65535
+  };
+/* Returns the sine of PHASE / 2^32 turns.  The top two bits of PHASE are
+   the quadrant; of the rest, the next 8 index the table, and 16 more are
+   used for interpolation.  */
+static fix16
+sin_phase (uint32_t phase) {
+  uint32_t p = (phase << 2) >> 8;
+  fix16 y;
+
+  if (phase & 0x40000000UL)
+    p = 0x1000000UL - p;
+
+  if (p >= 0x1000000UL)
+    y = FIX16_ONE;
+  else {
+    uint16_t i = p >> 16, f = p;
+    uint16_t y0 = sin_table[i];
+    uint16_t d = (i < 255)? sin_table[i + 1] - y0 : 0x10000L - y0;
+    y = y0 + (((uint32_t) d * f + 0x8000) >> 16);
+    }
+
+  return (phase & 0x80000000UL)? -y : y;
+  }
+
+/* Converts radians to a fraction of a turn, multiplying by 2^32 / (2 pi),
+   which is 0x28be60dc after scaling by 2^16, and keeping the low 32 bits
+   of the integral part.  The partial products are all 16 by 16 bits.  */
+static uint32_t
+phase_of (fix16 x) {
+  uint32_t ux = (x < 0)? -(uint32_t) x : x;
+  uint16_t xh = ux >> 16, xl = ux;
+  uint32_t p;
+
+  p = ((uint32_t) xh * 0x28be << 16) + (uint32_t) xh * 0x60dc
+      + (uint32_t) xl * 0x28be + (((uint32_t) xl * 0x60dc) >> 16);
+
+  return (x < 0)? -p : p;
+  }
+
+fix16
+fix16_sin (fix16 x) {
+  return sin_phase (phase_of (x));
+  }
+
+fix16
+fix16_cos (fix16 x) {
+  return sin_phase (phase_of (x) + 0x40000000UL);
+  }
+
+void
+fix16_sincos (fix16 x, fix16 *sinp, fix16 *cosp) {
+  uint32_t phase = phase_of (x);
+  *sinp = sin_phase (phase);
+  *cosp = sin_phase (phase + 0x40000000UL);
+  }
+
+fix16
+fix16_tan (fix16 x) {
+  uint32_t phase = phase_of (x);
+  return fix16_div (sin_phase (phase), sin_phase (phase + 0x40000000UL));
+  }
+
+/* 65536 atan (k / 256).  */
+static const uint16_t atan_table[257] = {
+  0, 256, 512, 768, 1024, 1280, 1536, 1792, 2047, 2303, 2559, 2814,
+  3070, 3325, 3580, 3836, 4091, 4346, 4600, 4855, 5110, 5364, 5618,
+  5872, 6126, 6380, 6633, 6887, 7140, 7392, 7645, 7898, 8150, 8402,
+  8653, 8905, 9156, 9407, 9657, 9908, 10158, 10408, 10657, 10906, 11155,
+  11403, 11652, 11899, 12147, 12394, 12641, 12887, 13133, 13379, 13624,
+  13869, 14114, 14358, 14601, 14845, 15088, 15330, 15572, 15814, 16055,
+  16296, 16536, 16776, 17015, 17254, 17492, 17730, 17968, 18205, 18441,
+  18677, 18913, 19148, 19382, 19616, 19850, 20083, 20315, 20547, 20779,
+  21009, 21240, 21469, 21699, 21927, 22156, 22383, 22610, 22836, 23062,
+  23288, 23512, 23737, 23960, 24183, 24406, 24627, 24849, 25069, 25289,
+  25509, 25727, 25946, 26163, 26380, 26597, 26813, 27028, 27242, 27456,
+  27670, 27882, 28094, 28306, 28517, 28727, 28936, 29145, 29354, 29561,
+  29768, 29975, 30180, 30386, 30590, 30794, 30997, 31200, 31402, 31603,
+  31803, 32003, 32203, 32401, 32600, 32797, 32994, 33190, 33385, 33580,
+  33774, 33968, 34160, 34353, 34544, 34735, 34925, 35115, 35304, 35492,
+  35680, 35867, 36053, 36239, 36424, 36608, 36792, 36975, 37158, 37340,
+  37521, 37701, 37881, 38060, 38239, 38417, 38594, 38771, 38947, 39123,
+  39297, 39472, 39645, 39818, 39990, 40162, 40333, 40503, 40673, 40842,
+  41010, 41178, 41346, 41512, 41678, 41844, 42008, 42172, 42336, 42499,
+  42661, 42823, 42984, 43145, 43304, 43464, 43622, 43780, 43938, 44095,
+  44251, 44407, 44562, 44716, 44870, 45024, 45176, 45328, 45480, 45631,
+  45781, 45931, 46080, 46229, 46377, 46525, 46672, 46818, 46964, 47109,
+  47254, 47398, 47542, 47685, 47827, 47969, 48111, 48251, 48392, 48531,
+  48671, 48809, 48947, 49085, 49222, 49359, 49495, 49630, 49765, 49899,
+  50033, 50167, 50299, 50432, 50563, 50695, 50826, 50956, 51086, 51215,
+  51344, 51472
+  };
+/* Returns atan (NUM / DEN), for NUM <= DEN and DEN non-zero.  If DEN is
+   more than 0x10000 (FIX16_ONE, as it is for fix16_atan), both are scaled
+   down, rounding, until DEN fits in 16 bits, so that the ratio can usually
+   be found with a single divu.  */
+static fix16
+atan_ratio (uint32_t num, uint32_t den) {
+  uint32_t r;
+  uint16_t i, f, s;
+
+  if (den > 0x10000UL) {
+    for (s = 1; (den >> s) > 0xffffUL; s++)
+      ;
+    num = (num >> s) + ((num >> (s - 1)) & 1);
+    den = (den >> s) + ((den >> (s - 1)) & 1);
+    }
+
+  if (num >= den)
+    return atan_table[256];
+
+  r = ((num << 16) + (den >> 1)) / den;
+  if (r >= 0x10000UL)
+    return atan_table[256];
+
+  i = r >> 8;
+  f = r & 0xff;
+  return atan_table[i]
+	 + (((atan_table[i + 1] - atan_table[i]) * f + 0x80) >> 8);
+  }
+
+fix16
+fix16_atan2 (fix16 y, fix16 x) {
+  uint32_t ux = (x < 0)? -(uint32_t) x : x;
+  uint32_t uy = (y < 0)? -(uint32_t) y : y;
+  fix16 t;
+
+  /* Reduce to the first octant, adding the constants as late as possible,
+     since each of them is rounded.  */
+  if (uy <= ux) {
+    if (ux == 0)
+      return 0;
+    t = atan_ratio (uy, ux);
+    if (x < 0)
+      t = FIX16_PI - t;
+    }
+  else {
+    t = atan_ratio (ux, uy);
+    t = (x < 0)? FIX16_PI_2 + t : FIX16_PI_2 - t;
+    }
+
+  return (y < 0)? -t : t;
+  }
+
+fix16
+fix16_atan (fix16 x) {
+  return fix16_atan2 (x, FIX16_ONE);
+  }
+
+/* The cosine of asin (x), sqrt (1 - x^2), is found with 32 fractional bits
+   as sqrt ((1 - |x|) (1 + |x|)), which avoids the loss of precision in
+   1 - x^2 as |x| approaches 1.  */
+static fix16
+cos_asin (fix16 x) {
+  uint32_t ux = (x < 0)? -(uint32_t) x : x;
+
+  if (ux == 0)
+    return FIX16_ONE;
+  else if (ux >= 0x10000UL)
+    return 0;
+  else
+    return __fix_root ((0x10000UL - ux) * (0x10000UL + ux), 16);
+  }
+
+fix16
+fix16_asin (fix16 x) {
+  if (x > FIX16_ONE)
+    x = FIX16_ONE;
+  else if (x < -FIX16_ONE)
+    x = -FIX16_ONE;
+  return fix16_atan2 (x, cos_asin (x));
+  }
+
+fix16
+fix16_acos (fix16 x) {
+  if (x > FIX16_ONE)
+    x = FIX16_ONE;
+  else if (x < -FIX16_ONE)
+    x = -FIX16_ONE;
+  return fix16_atan2 (cos_asin (x), x);
+  }
+
+/* In half turns, the top 16 bits of a phase are the angle itself.  */
+
+fix15
+fix15_sin (fix15 a) {
+  fix16 y = sin_phase ((uint32_t) (uint16_t) a << 16);
+  return fix16_to_fix15 (y);
+  }
+
+fix15
+fix15_cos (fix15 a) {
+  fix16 y = sin_phase (((uint32_t) (uint16_t) a << 16) + 0x40000000UL);
+  return fix16_to_fix15 (y);
+  }
+
+/* An angle of pi wraps around to -pi, which is the same thing.  */
+fix15
+fix15_atan2 (fix15 y, fix15 x) {
+  return (phase_of (fix16_atan2 (y, x)) + 0x8000) >> 16;
+  }
@@ -75,11 +75,11 @@ static float P[] = {
 static float MAXL10 = 38.230809449325611792f;
 
 #ifdef ANSIC
-float frexp(float, int *), polevl(float, float *, int);
+float frexp(float, int *);
 
 float log10(float xx)
 #else
-float frexp(), polevl();
+float frexp();
 
 float log10(xx)
 double xx;
@@ -118,7 +118,7 @@ else
 
 /* rational form */
 z = x*x;
-y = x * ( z * polevl( x, P, 8 ) );
+y = x * ( z * POLEVL8( x, P ) );
 y = y - 0.5f * z;   /*  y - 0.5 * x**2  */
 
 /* multiply log of fraction by log10(e)
@@ -74,11 +74,11 @@ static float P[] = {
 extern float MINLOGF, LOGE2F;
 
 #ifdef ANSIC
-float frexp(float, int *), polevl(float, float *, int);
+float frexp(float, int *);
 
 float log2(float xx)
 #else
-float frexp(), polevl();
+float frexp();
 
 float log2(xx)
 double xx;
@@ -115,7 +115,7 @@ else
 	}
 
 z = x*x;
-y = x * ( z * polevl( x, P, 8 ) );
+y = x * ( z * POLEVL8( x, P ) );
 y = y - 0.5f * z;   /*  y - 0.5f * x**2  */
 
 
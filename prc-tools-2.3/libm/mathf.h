@@ -136,6 +136,7 @@ extern int shichi ( float xx, float *si, float *ci );
 extern int sici ( float xx, float *si, float *ci );
 extern float sindg ( float xx );
 extern float sin ( float xx );
+extern void sincos ( float xx, float *s, float *c );
 extern float sinh ( float xx );
 extern float spence ( float xx );
 extern int sprec ( void );
@@ -146,6 +147,9 @@ extern float tandg ( float x );
 extern float tan ( float x );
 extern float tanh ( float xx );
 extern float threef0 ( float aa, float bb, float cc, float xx, float *err );
+extern void vcos ( const float *x, float *y, int n );
+extern void vsin ( const float *x, float *y, int n );
+extern void vsincos ( const float *x, float *s, float *c, int n );
 extern float y0 ( float xx );
 extern float y1 ( float xx );
 extern float yn ( int nn, float xx );
@@ -16,11 +16,36 @@
 /* Type of computer */
 /* define DEC 1 */
 /* #define IBMPC 1 */
-#define MIEEE 1
 /* define UNK 1 */
+/* The host-side tests define IBMPC on the command line.  */
+#ifndef IBMPC
+#define MIEEE 1
+#endif
 
 #define ANSIC 1
 /* get rid of this thing.  Takes too much space anyway */
 #define mtherr(a,b)
 
 #include "mathf.h"
+
+/* polevl( x, coef, N ) and p1evl( x, coef, N ) unrolled for a
+ * constant degree N, without the call and the loop.  x is
+ * evaluated more than once, so should be a plain variable.
+ */
+#define POLEVL1( x, c )	((c)[0] * (x) + (c)[1])
+#define POLEVL2( x, c )	(POLEVL1( x, c ) * (x) + (c)[2])
+#define POLEVL3( x, c )	(POLEVL2( x, c ) * (x) + (c)[3])
+#define POLEVL4( x, c )	(POLEVL3( x, c ) * (x) + (c)[4])
+#define POLEVL5( x, c )	(POLEVL4( x, c ) * (x) + (c)[5])
+#define POLEVL6( x, c )	(POLEVL5( x, c ) * (x) + (c)[6])
+#define POLEVL7( x, c )	(POLEVL6( x, c ) * (x) + (c)[7])
+#define POLEVL8( x, c )	(POLEVL7( x, c ) * (x) + (c)[8])
+
+#define P1EVL1( x, c )	((x) + (c)[0])
+#define P1EVL2( x, c )	(P1EVL1( x, c ) * (x) + (c)[1])
+#define P1EVL3( x, c )	(P1EVL2( x, c ) * (x) + (c)[2])
+#define P1EVL4( x, c )	(P1EVL3( x, c ) * (x) + (c)[3])
+#define P1EVL5( x, c )	(P1EVL4( x, c ) * (x) + (c)[4])
+#define P1EVL6( x, c )	(P1EVL5( x, c ) * (x) + (c)[5])
+#define P1EVL7( x, c )	(P1EVL6( x, c ) * (x) + (c)[6])
+#define P1EVL8( x, c )	(P1EVL7( x, c ) * (x) + (c)[7])
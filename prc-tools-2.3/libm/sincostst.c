@@ -0,0 +1,210 @@
+/* Host-side accuracy tests for sin, cos, sincos and the vector forms, and
+   for the functions that use the unrolled polynomials in mconf.h.
+
+   This is built with the host's compiler (see the sincostst target in
+   Makefile.in), with the libmf sources compiled alongside it and their
+   functions renamed so that they don't clash with the host's libm.  Each
+   function is compared with the host's double precision libm at the same
+   float argument, over sweeps of its domain and random arguments, and the
+   maximum error is reported in units of the last place of the correctly
+   rounded float result.  sincos and the vector forms must also give
+   exactly the same results as sin and cos, over the whole float range.
+   The test fails if any function exceeds the bound in its table entry.
+
+   This code is in the public domain.  */
+
+#include "mathf.h"
+
+/* The Makefile renames these with -D options, for the libmf sources too.  */
+#undef sin
+#undef cos
+#undef sincos
+#undef log2
+#undef log10
+#undef exp2
+#undef exp10
+#undef floor
+#undef ceil
+#undef frexp
+#undef ldexp
+#undef pow
+
+/* The host's libm.  <math.h> would clash with mathf.h.  */
+extern double sin (double), cos (double), log2 (double), log10 (double);
+extern double exp2 (double), pow (double, double), fabs (double);
+extern double ldexp (double, int);
+extern int ilogb (double);
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+static uint32_t seed = 1;
+
+static uint32_t
+random32 (void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+  }
+
+/* Uniformly distributed in [lo, hi).  */
+static float
+random_in (double lo, double hi) {
+  return lo + (hi - lo) * (random32 () / 4294967296.0);
+  }
+
+/* Any float bit pattern other than a NaN or an infinity.  */
+static float
+random_float (void) {
+  union { float f; uint32_t u; } v;
+
+  do
+    v.u = random32 ();
+  while ((v.u & 0x7f800000UL) == 0x7f800000UL);
+  return v.f;
+  }
+
+/* Reducing large arguments modulo pi/4 loses some absolute accuracy, so
+   sin and cos of large arguments are allowed an absolute error too, and
+   their results near zero may be off by many units in the last place.  */
+
+/* The size of a unit in the last place of a float near X.  */
+static double
+ulp (double x) {
+  int e = (x == 0)? -126 : ilogb (x);
+  return ldexp (1.0, ((e < -126)? -126 : e) - 23);
+  }
+
+struct test {
+  const char *name;
+  double lo, hi;		/* Domain.  */
+  double ulps, abs;		/* Allowed error: ULPS units in the last
+				   place, plus ABS.  */
+  double (*ref) (double x);
+  float (*fn) (float x);
+  };
+
+static double r_exp10 (double x) { return pow (10.0, x); }
+
+static float f_sin (float x) { return mf_sin (x); }
+static float f_cos (float x) { return mf_cos (x); }
+static float f_log2 (float x) { return mf_log2 (x); }
+static float f_log10 (float x) { return mf_log10 (x); }
+static float f_exp2 (float x) { return mf_exp2 (x); }
+static float f_exp10 (float x) { return mf_exp10 (x); }
+
+#define ABSERR	3e-11
+
+static const struct test tests[] = {
+  { "sin", -8192, 8192, 2, ABSERR, sin, f_sin },
+  { "sin", -3.2, 3.2, 2, 0, sin, f_sin },
+  { "cos", -8192, 8192, 2, ABSERR, cos, f_cos },
+  { "cos", -3.2, 3.2, 2, 0, cos, f_cos },
+  { "log2", 1e-30, 1e30, 2, 0, log2, f_log2 },
+  { "log2", 0.5, 2, 2, 0, log2, f_log2 },
+  { "log10", 1e-30, 1e30, 2, 0, log10, f_log10 },
+  { "log10", 0.5, 2, 2, 0, log10, f_log10 },
+  { "exp2", -126, 127, 2, 0, exp2, f_exp2 },
+  { "exp10", -37, 38, 2, 0, r_exp10, f_exp10 },
+  };
+
+#define NTESTS	(sizeof tests / sizeof tests[0])
+
+#define NSWEEP	200000
+#define NRANDOM	1000000
+
+static int
+run (const struct test *t) {
+  double max_ulps = 0, worst_x = 0;
+  int ok = 1;
+  long i;
+
+  for (i = 0; i < NSWEEP + NRANDOM; i++) {
+    float x, got;
+    double ref, err;
+
+    if (i < NSWEEP)
+      x = t->lo + (t->hi - t->lo) * i / NSWEEP;
+    else if (t->lo > 0)		/* Logarithmically distributed.  */
+      x = t->lo * pow (t->hi / t->lo, random32 () / 4294967296.0);
+    else
+      x = random_in (t->lo, t->hi);
+
+    ref = t->ref (x);
+    got = t->fn (x);
+
+    err = fabs (got - ref) / ulp ((float) ref);
+    if (fabs (got - ref) > t->ulps * ulp ((float) ref) + t->abs) {
+      if (ok)
+	printf ("%s (%.9g) = %.9g, should be %.9g\n", t->name, x, got, ref);
+      ok = 0;
+      }
+    if (err > max_ulps) {
+      max_ulps = err;
+      worst_x = x;
+      }
+    }
+
+  printf ("%-6s [%g, %g]: max %.2f ulps at %.9g\n",
+	  t->name, t->lo, t->hi, max_ulps, worst_x);
+  return ok;
+  }
+
+#define NVECTOR	1000
+
+/* sincos, vsin, vcos and vsincos must agree exactly with sin and cos.  */
+static int
+same (void) {
+  static float x[NVECTOR], s[NVECTOR], c[NVECTOR], vs[NVECTOR], vc[NVECTOR];
+  long n, bad = 0;
+  int i;
+
+  for (n = 0; n < 1000; n++) {
+    for (i = 0; i < NVECTOR; i++)
+      x[i] = (i % 2)? random_float () : random_in (-100, 100);
+
+    vsin (x, vs, NVECTOR);
+    vcos (x, vc, NVECTOR);
+    for (i = 0; i < NVECTOR; i++) {
+      float si, ci;
+
+      mf_sincos (x[i], &si, &ci);
+      s[i] = mf_sin (x[i]);
+      c[i] = mf_cos (x[i]);
+      if (memcmp (&si, &s[i], sizeof (float)) != 0
+	  || memcmp (&ci, &c[i], sizeof (float)) != 0
+	  || memcmp (&vs[i], &s[i], sizeof (float)) != 0
+	  || memcmp (&vc[i], &c[i], sizeof (float)) != 0) {
+	if (bad++ == 0)
+	  printf ("sincos (%.9g) differs from sin and cos\n", x[i]);
+	}
+      }
+
+    vsincos (x, vs, vc, NVECTOR);
+    if (memcmp (vs, s, sizeof s) != 0 || memcmp (vc, c, sizeof c) != 0) {
+      if (bad++ == 0)
+	printf ("vsincos differs from sin and cos\n");
+      }
+    }
+
+  printf ("sincos: %ld arguments, %ld differences\n", n * NVECTOR, bad);
+  return (bad == 0);
+  }
+
+int
+main () {
+  unsigned i;
+  int ok = 1;
+
+  for (i = 0; i < NTESTS; i++)
+    if (! run (&tests[i]))
+      ok = 0;
+
+  if (! same ())
+    ok = 0;
+
+  printf ((ok)? "All tests passed\n" : "Some tests FAILED\n");
+  return (ok)? 0 : 1;
+  }
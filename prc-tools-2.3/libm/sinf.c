@@ -77,6 +77,30 @@
  *    IEEE    -8192,+8192   100,000      3.0e-7     3.0e-8
  */
 
+/*							sincos.c
+ *
+ *	Circular sine and cosine together
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * float x, s, c;
+ * void sincos();
+ *
+ * sincos( x, &s, &c );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * sincos() stores the sine and cosine of x in s and c.  The
+ * range reduction and x**2 are shared, so this costs about
+ * as much as sin() alone plus one polynomial.  The results
+ * are identical to those of sin() and cos().
+ *
+ */
+
 /*
 Cephes Math Library Release 2.2:  June, 1992
 Copyright 1985, 1987, 1988, 1992 by Stephen L. Moshier
@@ -122,6 +146,67 @@ static float coscof[] = {
  4.166664568298827E-002
 };
 
+/* Reduce x >= 0 modulo pi/4, leaving the remainder, in
+ * [-pi/4, +pi/4], in *xr.  Returns the octant, 0 to 7.
+ * j must be a long: with 16 bit ints, x/(PI/4) overflows.
+ */
+static int
+reduce( float x, float *xr )
+{
+float y;
+unsigned long j;
+
+j = FOPI * x; /* integer part of x/(PI/4) */
+y = j;
+/* map zeros to origin */
+if( j & 1 )
+	{
+	j += 1;
+	y += 1.0f;
+	}
+if( x > lossth )
+	{
+	mtherr( "sin", PLOSS );
+	x = x - y * PIO4F;
+	}
+else
+	{
+/* Extended precision modular arithmetic */
+	x = ((x - y * DP1) - y * DP2) - y * DP3;
+	}
+*xr = x;
+return( j & 7 );
+}
+
+/* sin(x) for x in [-pi/4, +pi/4], with z = x**2.
+ * Theoretical relative error = 3.8e-9 in [-pi/4, +pi/4]
+ */
+static __inline__ float
+sinpoly( float x, float z )
+{
+float y;
+
+y = POLEVL2( z, sincof );
+y *= z * x;
+y += x;
+return( y );
+}
+
+/* cos(x) for x in [-pi/4, +pi/4], with z = x**2.
+ * measured relative error in +/- pi/4 is 7.8e-8
+ */
+static __inline__ float
+cospoly( float z )
+{
+float y;
+
+y = POLEVL2( z, coscof );
+y *= z * z;
+y -= 0.5f * z;
+y += 1.0f;
+return( y );
+}
+
 #ifdef ANSIC
 float sin( float xx )
 #else
@@ -129,10 +214,8 @@ float sin(xx)
 double xx;
 #endif
 {
-float *p;
 float x, y, z;
-register unsigned long j;
-register int sign;
+int j, sign;
 
 sign = 1;
 x = xx;
@@ -146,67 +229,18 @@ if( x > T24M1 )
 	mtherr( "sin", TLOSS );
 	return(0.0f);
 	}
-j = FOPI * x; /* integer part of x/(PI/4) */
-y = j;
-/* map zeros to origin */
-if( j & 1 )
-	{
-	j += 1;
-	y += 1.0f;
-	}
-j &= 7; /* octant modulo 360 degrees */
+j = reduce( x, &x );
 /* reflect in x axis */
 if( j > 3)
 	{
 	sign = -sign;
 	j -= 4;
 	}
-
-if( x > lossth )
-	{
-	mtherr( "sin", PLOSS );
-	x = x - y * PIO4F;
-	}
-else
-	{
-/* Extended precision modular arithmetic */
-	x = ((x - y * DP1) - y * DP2) - y * DP3;
-	}
-/*einits();*/
 z = x * x;
 if( (j==1) || (j==2) )
-	{
-/* measured relative error in +/- pi/4 is 7.8e-8 */
-/*
-	y = ((  2.443315711809948E-005f * z
-	  - 1.388731625493765E-003f) * z
-	  + 4.166664568298827E-002f) * z * z;
-*/
-	p = coscof;
-	y = *p++;
-	y = y * z + *p++;
-	y = y * z + *p++;
-	y *= z * z;
-	y -= 0.5f * z;
-	y += 1.0f;
-	}
+	y = cospoly( z );
 else
-	{
-/* Theoretical relative error = 3.8e-9 in [-pi/4, +pi/4] */
-/*
-	y = ((-1.9515295891E-4f * z
-	     + 8.3321608736E-3f) * z
-	     - 1.6666654611E-1f) * z * x;
-	y += x;
-*/
-	p = sincof;
-	y = *p++;
-	y = y * z + *p++;
-	y = y * z + *p++;
-	y *= z * x;
-	y += x;
-	}
-/*einitd();*/
+	y = sinpoly( x, z );
 if(sign < 0)
 	y = -y;
 return( y);
@@ -241,53 +275,73 @@ if( x > T24M1 )
 	mtherr( "cos", TLOSS );
 	return(0.0f);
 	}
-
-j = FOPI * x; /* integer part of x/PIO4 */
-y = j;
-/* integer and fractional part modulo one octant */
-if( j & 1 )	/* map zeros to origin */
-	{
-	j += 1;
-	y += 1.0f;
-	}
-j &= 7;
+j = reduce( x, &x );
 if( j > 3)
 	{
 	j -=4;
 	sign = -sign;
 	}
-
 if( j > 1 )
 	sign = -sign;
 
-if( x > lossth )
+z = x * x;
+if( (j==1) || (j==2) )
+	y = sinpoly( x, z );
+else
+	y = cospoly( z );
+if(sign < 0)
+	y = -y;
+return( y );
+}
+
+
+#ifdef ANSIC
+void sincos( float xx, float *s, float *c )
+#else
+void sincos( xx, s, c )
+double xx;
+float *s, *c;
+#endif
+{
+float x, ys, yc, z;
+int j, ssign, csign;
+
+ssign = 1;
+csign = 1;
+x = xx;
+if( xx < 0 )
 	{
-	mtherr( "cos", PLOSS );
-	x = x - y * PIO4F;
+	ssign = -1;
+	x = -xx;
 	}
-else
-/* Extended precision modular arithmetic */
-	x = ((x - y * DP1) - y * DP2) - y * DP3;
+if( x > T24M1 )
+	{
+	mtherr( "sincos", TLOSS );
+	*s = 0.0f;
+	*c = 0.0f;
+	return;
+	}
+j = reduce( x, &x );
+if( j > 3)
+	{
+	ssign = -ssign;
+	csign = -csign;
+	j -= 4;
+	}
+if( j > 1 )
+	csign = -csign;
 
 z = x * x;
-
+ys = sinpoly( x, z );
+yc = cospoly( z );
 if( (j==1) || (j==2) )
 	{
-	y = (((-1.9515295891E-4f * z
-	     + 8.3321608736E-3f) * z
-	     - 1.6666654611E-1f) * z * x)
-	     + x;
+	*s = (ssign < 0)? -yc : yc;
+	*c = (csign < 0)? -ys : ys;
 	}
 else
 	{
-	y = ((  2.443315711809948E-005f * z
-	  - 1.388731625493765E-003f) * z
-	  + 4.166664568298827E-002f) * z * z;
-	y -= 0.5f * z;
-	y += 1.0f;
+	*s = (ssign < 0)? -ys : ys;
+	*c = (csign < 0)? -yc : yc;
 	}
-if(sign < 0)
-	y = -y;
-return( y );
 }
-
@@ -0,0 +1,68 @@
+/*							vsinf.c
+ *
+ *	Circular sine and cosine of arrays
+ *
+ *
+ *
+ * SYNOPSIS:
+ *
+ * int N;
+ * float x[N], s[N], c[N], y[N];
+ * void vsin(), vcos(), vsincos();
+ *
+ * vsin( x, y, N );
+ * vcos( x, y, N );
+ * vsincos( x, s, c, N );
+ *
+ *
+ *
+ * DESCRIPTION:
+ *
+ * Stores the sine, the cosine, or both, of each of the N
+ * elements of x in the corresponding elements of y, or of
+ * s and c.  vsincos() uses sincos(), so shares the range
+ * reduction between the sine and cosine of each element.
+ * The results are identical to those of sin() and cos().
+ *
+ * These are kept apart from sin() and cos() so that they
+ * are only linked into programs that use them.
+ *
+ */
+
+#include "mconf.h"
+
+#ifdef ANSIC
+void vsin( const float *x, float *y, int n )
+#else
+void vsin( x, y, n )
+float *x, *y;
+int n;
+#endif
+{
+while( --n >= 0 )
+	*y++ = sin( *x++ );
+}
+
+#ifdef ANSIC
+void vcos( const float *x, float *y, int n )
+#else
+void vcos( x, y, n )
+float *x, *y;
+int n;
+#endif
+{
+while( --n >= 0 )
+	*y++ = cos( *x++ );
+}
+
+#ifdef ANSIC
+void vsincos( const float *x, float *s, float *c, int n )
+#else
+void vsincos( x, s, c, n )
+float *x, *s, *c;
+int n;
+#endif
+{
+while( --n >= 0 )
+	sincos( *x++, s++, c++ );
+}
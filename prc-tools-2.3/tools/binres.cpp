@@ -110,23 +110,26 @@ make_main_code_m68k (Datablock& res, const char* fname, unsigned long entry) {
 
 static Datablock
 make_main_code_arm (Datablock& res, const char* fname, unsigned long entry) {
-  if (entry > 33554432)
+  if (entry & 1) {
+    /* A Thumb entry point, whose address has its low bit set.  Palm OS calls
+       the code in ARM state, so we switch to Thumb state first, using an
+       offset so that the code still works wherever it is loaded.  */
+    res = res (-16, res.size () + 16);
+    unsigned char* s = res.writable_contents ();
+    put_arm_long (s, 0xe59fc004);	// ldr ip, [pc, #4]
+    put_arm_long (s, 0xe08cc00f);	// add ip, ip, pc
+    put_arm_long (s, 0xe12fff1c);	// bx ip
+    put_arm_long (s, entry + 4);		// OFF = (16 + entry) - 12, from pc
+    }
+  else if (entry > 33554432)
     error ("[%s] entry point 0x%lx too distant", fname, entry);
   else if (entry > 0) {
     res = res (-4, res.size () + 4);
     unsigned char* s = res.writable_contents ();
 
-    /* This is the first code that needs to write something ARM-endian!
-       FIXME Use some put_arm_word-style functions.  */
-
     // On ARM, a jump offset is measured in 32-bit words and is relative to the
     // instruction after next -- 0 corresponds to skipping one instruction.
-    entry = (entry - 4) >> 2;
-
-    put_byte (s, entry & 0xff);
-    put_byte (s, (entry >>  8) & 0xff);
-    put_byte (s, (entry >> 16) & 0xff);
-    put_byte (s, 0xea);		// b OFF
+    put_arm_long (s, 0xea000000 | ((entry - 4) >> 2));	// b OFF
     }
 
   return res;
@@ -25,6 +25,7 @@ Creates assembly stub file '<base>.s' and linker script '<base>.ld' from\n\
 multiple code clause in <deffile>; <base> is '<deffile>-sections' by default.\n\
 Options:\n", progname);
   propt ("-b FILE, --base FILE", "Set output filename base prefix");
+  propt ("-l, --lazy", "Load code resources when first used");
   }
 
 enum {
@@ -32,10 +33,11 @@ enum {
   OPTION_VERSION
   };
 
-static const char shortopts[] = "b:";
+static const char shortopts[] = "b:l";
 
 struct option longopts[] = {
   { "base", required_argument, NULL, 'b' },
+  { "lazy", no_argument, NULL, 'l' },
   { "help", no_argument, NULL, OPTION_HELP },
   { "version", no_argument, NULL, OPTION_VERSION },
   { NULL, no_argument, NULL, 0 }
@@ -48,6 +50,7 @@ struct section_entry {
   };
 
 static const char *deffname;
+static int lazy = 0;
 static struct section_entry *first_section_entry = NULL;
 static struct section_entry **next_section_entry_ptr = &first_section_entry;
 
@@ -73,8 +76,11 @@ filter (FILE *f, const char *key) {
   else if (strcmp (key, "@sec-entries@") == 0)
     for (e = first_section_entry; e; e = e->next)
       fprintf (f, "\t%s : { *(%s) } > %sres\n", e->name, e->name, e->name);
+  else if (strcmp (key, "@lazy@") == 0)
+    fprintf (f, "%s", lazy? "Lazy" : "");
   else if (strcmp (key, "@variables@") == 0) {
     struct section_entry main_section;
+    int n = 0;
 
     main_section.name = "";
     main_section.next = first_section_entry;
@@ -82,6 +88,12 @@ filter (FILE *f, const char *key) {
     for (e = &main_section; e; e = e->next) {
       fprintf (f, "\t.globl\t__text__%s\n", e->name);
       fprintf (f, "\t.lcomm\t__text__%s,4\n", e->name);
+      n++;
+      }
+
+    if (lazy) {
+      fprintf (f, "\t.globl\t_GccCodeHandles\n");
+      fprintf (f, "\t.lcomm\t_GccCodeHandles,%d\n", 4 * n);
       }
     }
   else
@@ -117,6 +129,10 @@ main (int argc, char **argv) {
       outfbase = optarg;
       break;
 
+    case 'l':
+      lazy = 1;
+      break;
+
     case OPTION_HELP:
       usage ();
       work_desired = 0;
@@ -101,4 +101,11 @@ put_slong (unsigned char*& s, signed long v) {
   put_long (s, u);
   }
 
+/* ARM instructions, unlike everything else here, are little-endian.  */
+
+inline void
+put_arm_long (unsigned char*& s, unsigned long v) {
+  *s++ = v, *s++ = v >> 8, *s++ = v >> 16, *s++ = v >> 24;
+  }
+
 #endif
@@ -5,6 +5,11 @@
 struct LibRef;
 static struct LibRef *libref = 0;
 
+/* The library's trampoline, which is the first word of its globals.  Once
+   this has been cached, calls go straight to it rather than through
+   GLibDispatch.  */
+static void *trampoline = 0;
+
 extern void GLibClose(struct LibRef *);
 
 #if __GNUC__ > 2 || (__GNUC__ == 2 && __GNUC_MINOR__ >= 95)
@@ -33,27 +38,55 @@ libname:
     .even
 
 dispatch:
-    lea libname(%%pc),%%a1
-    move.l %%a1,%%d2
-
     .ifdef A4_GLOBALS
     move.l %%a4,%%d1
-    move.l %%d1,%%d1
     jbeq noglobals
     .endif
 
-    lea %0,%%a1
-noglobals:
     move.l %1,%%d1
+    jbeq bind
+    move.l %%d1,%%a1
+    move.l %0,-(%%sp)
+    move.l %%d0,-(%%sp)
+    jmp (%%a1)
+
+    |
+    | Open the library if need be, and cache its trampoline.
+    |
+bind:
+    move.l %%d0,-(%%sp)
+    move.l %0,%%d1
+    jbne bound
+    pea libname(%%pc)
+    move.l %2,-(%%sp)
+    bsr.w GLibOpen
+    addq.l #8,%%sp
+    move.l %%a0,%0
+    move.l %%a0,%%d1
+bound:
+    move.l %%d1,%%a0
+    move.l 4(%%a0),%%a0
+    move.l (%%a0),%1
+    move.l (%%sp)+,%%d0
+    bra.s dispatch
+
+    |
+    | Without globals, GLibDispatch has to find the library every time.
+    |
+noglobals:
+    lea libname(%%pc),%%a1
+    move.l %%a1,%%d2
+    move.l %2,%%d1
     braw GLibDispatch
-    " : : "g" (libref), "i" ('@crid@') );
+    " : "+m" (libref), "+m" (trampoline) : "i" ('@crid@') );
 }
 
 #ifdef A4_GLOBALS
 
-/* The 0.5.0 distribution didn't use a .dtors section.  In order to
-   be usable with that compiler, we use a .ehook function and check
-   for globals ourselves.  */
+/* The 0.5.0 distribution didn't use a .dtors section, so code using %a4
+   globals gets a gehook function instead.  That section is collected by
+   the current linker script and crt0, not by those from 0.5.0, which
+   collected only ehook.  We still check for globals ourselves.  */
 
 register void *reg_a4 asm("%a4");
 
@@ -63,11 +96,12 @@ GLib_@crid@_clean(unsigned short cmd, void *PBP, unsigned short flags)
     if (reg_a4 && libref) {
 	GLibClose(libref);
 	libref = 0;
+	trampoline = 0;
     }
 }
 
 static void *hook
-  __attribute__ ((section ("ehook"), unused)) = GLib_@crid@_clean;
+  __attribute__ ((section ("gehook"), unused)) = GLib_@crid@_clean;
 
 #else
 
@@ -77,6 +111,7 @@ GLib_@crid@_clean()
     if (libref) {
 	GLibClose(libref);
 	libref = 0;
+	trampoline = 0;
     }
 }
 
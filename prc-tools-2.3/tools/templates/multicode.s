@@ -9,7 +9,7 @@
 .text
 	.globl	_GccRelocateData
 _GccRelocateData:
-	bra.w	_GccLoadCodeAndRelocateData
+	bra.w	_Gcc@lazy@LoadCodeAndRelocateData
 
-.section ehook
-	.long	_GccReleaseCode
+.section gehook
+	.long	_Gcc@lazy@ReleaseCode